@@ -1,5 +1,10 @@
-uniform vec2 displayAreaPos;
-uniform vec2 displayAreaSize;
+// Updated once per frame, see OpenGL::FrameConstants
+layout(std140) uniform FrameConstants {
+    vec2 displayAreaPos;
+    vec2 displayAreaSize;
+    vec2 vramSize;
+    bool is24bit;
+};
 
 uniform sampler2D vram;
 
@@ -18,9 +23,6 @@ const uint BplusF = 1u;
 const uint BminusF = 2u;
 const uint BplusFby4 = 3u;
 
-const float W = 1024.f;
-const float H = 512.f;
-
 SHARED vec3 fragColor;
 SHARED vec2 fragTexcoord;
 flat SHARED uvec3 fragFlatColor;
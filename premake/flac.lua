@@ -11,6 +11,7 @@ project "flac"
     files { 
         "../externals/flac/src/libFLAC/bitmath.c",
         "../externals/flac/src/libFLAC/bitreader.c",
+        "../externals/flac/src/libFLAC/bitwriter.c",
         "../externals/flac/src/libFLAC/cpu.c",
         "../externals/flac/src/libFLAC/crc.c",
         "../externals/flac/src/libFLAC/fixed.c",
@@ -28,6 +29,11 @@ project "flac"
         "../externals/flac/src/libFLAC/metadata_iterators.c",
         "../externals/flac/src/libFLAC/metadata_object.c",
         "../externals/flac/src/libFLAC/stream_decoder.c",
+        "../externals/flac/src/libFLAC/stream_encoder.c",
+        "../externals/flac/src/libFLAC/stream_encoder_framing.c",
+        "../externals/flac/src/libFLAC/stream_encoder_intrin_avx2.c",
+        "../externals/flac/src/libFLAC/stream_encoder_intrin_sse2.c",
+        "../externals/flac/src/libFLAC/stream_encoder_intrin_ssse3.c",
         "../externals/flac/src/libFLAC/window.c",
     }
     filter "system:windows" 
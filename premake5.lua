@@ -167,6 +167,8 @@ project "core"
 		"externals/json/include",
 		"externals/stb",
 		"externals/miniz",
+		"externals/lzma/C",
+		"externals/flac/include",
 		"externals/libchdr/src",
 		"externals/EventBus/lib/include",
 		"externals/magic_enum/include",
@@ -174,6 +176,8 @@ project "core"
 		"externals/cereal/include",
 	}
 
+	defines "FLAC__NO_DLL"
+
 	files { 
 		"src/**.h", 
 		"src/**.cpp"
@@ -312,7 +316,9 @@ project "avocado_test"
 
 	includedirs { 
 		"src", 
-		"externals/catch/single_include"
+		"tests/unit",
+		"externals/catch/single_include",
+		"externals/EventBus/lib/include",
 	}
 
 	files { 
@@ -322,9 +328,19 @@ project "avocado_test"
 	}
 
 	links {
-		"core"
+		"core",
+		"fmt",
+		"miniz",
+		"lzma",
+		"flac",
+		"chdr",
 	}
 
+	filter "system:linux"
+		links {
+			"pthread",
+		}
+
 project "avocado_autotest"
 	uuid "fcc880bc-c6fe-4b2b-80dc-d247345a1274"
 	kind "ConsoleApp"
@@ -345,3 +361,57 @@ project "avocado_autotest"
 		"core",
 		"fmt"
 	}
+
+group "tools"
+project "ecm2bin"
+	uuid "0649c18d-8587-4aa9-aab9-0cfc817aa6a2"
+	kind "ConsoleApp"
+	location "build/libs/ecm2bin"
+
+	includedirs { 
+		"src", 
+	}
+
+	files { 
+		"src/platform/null/file/**.*",
+		"tools/ecm2bin/**.cpp"
+	}
+
+	links {
+		"core",
+		"fmt"
+	}
+
+	filter "system:linux"
+		links {
+			"pthread",
+		}
+
+project "disc2cbin"
+	uuid "032a7552-a52f-47f2-9132-5323525d8a00"
+	kind "ConsoleApp"
+	location "build/libs/disc2cbin"
+
+	includedirs { 
+		"src", 
+		"externals/libchdr/src",
+	}
+
+	files { 
+		"src/platform/null/file/**.*",
+		"tools/disc2cbin/**.cpp"
+	}
+
+	links {
+		"core",
+		"fmt",
+		"miniz",
+		"lzma",
+		"flac",
+		"chdr",
+	}
+
+	filter "system:linux"
+		links {
+			"pthread",
+		}
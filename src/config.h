@@ -68,11 +68,16 @@ struct avocado_config_t {
 
         struct {
             bool enabled = true;
+            int blockSize = 1;  // SPU samples rendered at once, 1 - render every sample immediately
         } sound;
 
         struct {
             bool preserveState = true;
             bool timeTravel = false;
+            bool readAhead = true;     // Read disc image on a background thread ahead of the emulated drive
+            int chdCacheSize = 16;     // Decompressed .chd hunks kept in memory
+            int chdThreads = 2;        // Hunks decompressed in parallel ahead of reads, 0 - disabled
+            bool instantDisc = false;  // Skip seek and sector read delays, data is delivered as fast as the game takes it
         } emulator;
 
     } options;
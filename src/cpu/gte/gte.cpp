@@ -1,7 +1,9 @@
 #include "gte.h"
 #include "config.h"
+#include "utils/free_cam.h"
+#include "utils/screenshot.h"
 
-GTE::GTE() : unrTable(generateUnrTable()) {
+GTE::GTE() : unrTable(generateUnrTable()), recipTable(generateRecipTable()) {
     busToken = bus.listen<Event::Config::Gte>([&](auto) { reload(); });
     reload();
 }
@@ -16,12 +18,33 @@ constexpr std::array<uint8_t, 0x101> GTE::generateUnrTable() {
     return table;
 }
 
+std::vector<uint32_t> GTE::generateRecipTable() {
+    std::vector<uint32_t> table(0x8000);
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = recip(i | 0x8000);
+    }
+    return table;
+}
+
 void GTE::reload() {
     widescreenHack = config.options.graphics.forceWidescreen;
     logging = config.debug.log.gte;
+    updateHooks();
+}
+
+void GTE::updateHooks() {
+    Screenshot* screenshot = Screenshot::getInstance();
+    FreeCamera* freeCamera = FreeCamera::getInstance();
+    bool hooks = logging || screenshot->enabled || screenshot->debug || screenshot->doubleSided || screenshot->disableFog
+                 || freeCamera->enabled;
+
+    readHandler = logging ? &GTE::readRegister<true> : &GTE::readRegister<false>;
+    writeHandler = logging ? &GTE::writeRegister<true> : &GTE::writeRegister<false>;
+    commandHandler = hooks ? &GTE::execute<true> : &GTE::execute<false>;
 }
 
-uint32_t GTE::read(uint8_t n) {
+template <bool logged>
+uint32_t GTE::readRegister(uint8_t n) {
     uint32_t ret = [this](uint8_t n) -> uint32_t {
         switch (n) {
             case 0: return ((uint16_t)v[0].y << 16) | (uint16_t)v[0].x;
@@ -105,14 +128,15 @@ uint32_t GTE::read(uint8_t n) {
         }
     }(n);
 
-    if (logging) {
+    if (logged) {
         log.push_back({GTE_ENTRY::MODE::read, n, ret});
     }
     return ret;
 }
 
-void GTE::write(uint8_t n, uint32_t d) {
-    if (logging) {
+template <bool logged>
+void GTE::writeRegister(uint8_t n, uint32_t d) {
+    if (logged) {
         log.push_back({GTE_ENTRY::MODE::write, n, d});
     }
     switch (n) {
@@ -261,8 +285,9 @@ void GTE::write(uint8_t n, uint32_t d) {
     }
 }
 
-void GTE::command(gte::Command& cmd) {
-    if (logging) {
+template <bool hooks>
+void GTE::execute(gte::Command& cmd) {
+    if (hooks && logging) {
         log.push_back({GTE_ENTRY::MODE::func, cmd.cmd, 0});
     }
 
@@ -271,10 +296,10 @@ void GTE::command(gte::Command& cmd) {
     this->lm = cmd.lm;
 
     switch (cmd.cmd) {
-        case 0x01: rtps(); break;
-        case 0x06: nclip(); break;
+        case 0x01: rtps<hooks>(); break;
+        case 0x06: nclip<hooks>(); break;
         case 0x0c: op(); break;
-        case 0x10: dpcs(); break;
+        case 0x10: dpcs<hooks>(); break;
         case 0x11: intpl(); break;
         case 0x12: mvmva(cmd.mvmvaMultiplyMatrix, cmd.mvmvaMultiplyVector, cmd.mvmvaTranslationVector); break;
         case 0x13: ncds(); break;
@@ -284,12 +309,12 @@ void GTE::command(gte::Command& cmd) {
         case 0x1c: cc(); break;
         case 0x1e: ncs(); break;
         case 0x20: nct(); break;
-        case 0x2a: dpct(); break;
+        case 0x2a: dpct<hooks>(); break;
         case 0x28: sqr(); break;
         case 0x29: dcpl(); break;
         case 0x2d: avsz3(); break;
         case 0x2e: avsz4(); break;
-        case 0x30: rtpt(); break;
+        case 0x30: rtpt<hooks>(); break;
         case 0x3d: gpf(); break;
         case 0x3e: gpl(); break;
         case 0x3f: ncct(); break;
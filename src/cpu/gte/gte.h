@@ -66,9 +66,24 @@ class GTE {
     friend gui::debug::GTE;
 
     const std::array<uint8_t, 0x101> unrTable;
+    const std::vector<uint32_t> recipTable;  // recip() results for normalized divisors (0x8000 - 0xffff)
     int busToken;
     bool widescreenHack;
     bool logging;
+
+    // Handlers are selected by updateHooks(), the ones without hooks skip
+    // logging, 3D screenshot and free camera checks entirely
+    uint32_t (GTE::*readHandler)(uint8_t n);
+    void (GTE::*writeHandler)(uint8_t n, uint32_t d);
+    void (GTE::*commandHandler)(gte::Command& cmd);
+
+    template <bool logged>
+    uint32_t readRegister(uint8_t n);
+    template <bool logged>
+    void writeRegister(uint8_t n, uint32_t d);
+    template <bool hooks>
+    void execute(gte::Command& cmd);
+
     bool sf;  // Used for setMac and setIr functions
     bool lm;  // saved as fields to prevent passing them to every function
 
@@ -99,6 +114,7 @@ class GTE {
     Flag flag;
 
     constexpr std::array<uint8_t, 0x101> generateUnrTable();
+    std::vector<uint32_t> generateRecipTable();
     void reload();
 
     // Internal operations and helpers
@@ -125,6 +141,9 @@ class GTE {
     template <int i>
     void setMacAndIr(int64_t value, bool lm = false);
 
+    // All 3 components at once, same as setMacAndIr<1..3>
+    void setMacAndIr(gte::Vector<int64_t> value, bool lm = false);
+
     void setOtz(int64_t value);
     void pushScreenXY(int32_t x, int32_t y);
     void pushScreenZ(int32_t z);
@@ -136,6 +155,7 @@ class GTE {
     uint32_t divide(uint16_t h, uint16_t sz3);
 
     // Opcodes
+    template <bool hooks>
     void nclip();
     void ncds(int n = 0);
     void ncs(int n = 0);
@@ -145,11 +165,15 @@ class GTE {
     void cdp();
     void ncdt();
     void ncct();
+    template <bool hooks>
     void dpct();
+    template <bool hooks>
     void dpcs(bool useRGB0 = false);
     void dcpl();
     void intpl();
+    template <bool hooks>
     void rtps(int n = 0, bool setMAC0 = true, bool fromRTPT = false);
+    template <bool hooks>
     void rtpt();
     void avsz3();
     void avsz4();
@@ -171,9 +195,12 @@ class GTE {
     GTE();
     ~GTE();
 
-    uint32_t read(uint8_t n);
-    void write(uint8_t n, uint32_t d);
-    void command(gte::Command& cmd);
+    uint32_t read(uint8_t n) { return (this->*readHandler)(n); }
+    void write(uint8_t n, uint32_t d) { (this->*writeHandler)(n, d); }
+    void command(gte::Command& cmd) { (this->*commandHandler)(cmd); }
+
+    // Must be called after logging, 3D screenshot or free camera has been toggled
+    void updateHooks();
 
     template <class Archive>
     void serialize(Archive& ar) {
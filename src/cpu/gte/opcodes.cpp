@@ -2,10 +2,94 @@
 #include "utils/screenshot.h"
 #include "utils/free_cam.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 using gte::Matrix;
 using gte::toVector;
 using gte::Vector;
 
+#ifdef __AVX2__
+namespace simd {
+// Lanes 0-2 hold x/y/z (r/g/b) components, lane 3 is unused.
+// Flag bits for components are in reversed order (MAC1 is bit 30, MAC3 is bit 28)
+constexpr uint32_t reverseLanes[8] = {0b000, 0b100, 0b010, 0b110, 0b001, 0b101, 0b011, 0b111};
+
+inline __m256i load(int64_t x, int64_t y, int64_t z) { return _mm256_set_epi64x(0, z, y, x); }
+
+inline uint32_t laneMask(__m256i mask) { return reverseLanes[_mm256_movemask_pd(_mm256_castsi256_pd(mask)) & 7]; }
+
+inline uint32_t laneMask(__m128i mask) { return reverseLanes[_mm_movemask_ps(_mm_castsi128_ps(mask)) & 7]; }
+
+// MACn overflow flags for 44bit values
+inline uint32_t macOverflow(__m256i value) {
+    const __m256i max = _mm256_set1_epi64x((1LL << 43) - 1);
+    const __m256i min = _mm256_set1_epi64x(-(1LL << 43));
+
+    uint32_t positive = laneMask(_mm256_cmpgt_epi64(value, max));
+    uint32_t negative = laneMask(_mm256_cmpgt_epi64(min, value));
+    return (positive << 28) | (negative << 25);
+}
+
+// extend_sign<44> for each lane
+inline __m256i extend44(__m256i value) {
+    const __m256i mask = _mm256_set1_epi64x((1LL << 44) - 1);
+    const __m256i sign = _mm256_set1_epi64x(1LL << 43);
+    return _mm256_sub_epi64(_mm256_xor_si256(_mm256_and_si256(value, mask), sign), sign);
+}
+
+// Lower 32 bits of each lane, equivalent to (int32_t) cast
+inline __m128i truncate(__m256i value) {
+    const __m256i index = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(value, index));
+}
+
+// Value of setMac<1..3> passed to setIr. Only bits 12..43 are used when shifting,
+// so logical shift gives the same result as arithmetic one.
+inline __m128i macValue(__m256i value, bool sf) { return truncate(sf ? _mm256_srli_epi64(value, 12) : value); }
+
+// IRn saturation flags
+inline uint32_t irSaturation(__m128i value, __m128i min) {
+    const __m128i max = _mm_set1_epi32(0x7fff);
+    return laneMask(_mm_or_si128(_mm_cmpgt_epi32(value, max), _mm_cmplt_epi32(value, min))) << 22;
+}
+
+inline __m128i irMin(bool lm) { return _mm_set1_epi32(lm ? 0 : -0x8000); }
+
+inline __m128i saturateIr(__m128i value, __m128i min) { return _mm_min_epi32(_mm_max_epi32(value, min), _mm_set1_epi32(0x7fff)); }
+
+inline void store(int32_t dst[3], __m128i value) {
+    dst[0] = _mm_extract_epi32(value, 0);
+    dst[1] = _mm_extract_epi32(value, 1);
+    dst[2] = _mm_extract_epi32(value, 2);
+}
+
+inline void store(int16_t dst[3], __m128i value) {
+    dst[0] = _mm_extract_epi32(value, 0);
+    dst[1] = _mm_extract_epi32(value, 1);
+    dst[2] = _mm_extract_epi32(value, 2);
+}
+
+// tr * 0x1000 + m * v, with 44bit overflow check and sign extension after every addition
+inline __m256i mulMatrixVector(uint32_t& flags, const Matrix& m, Vector<int16_t> v, Vector<int32_t> tr) {
+    __m256i result = load((int64_t)tr.x << 12, (int64_t)tr.y << 12, (int64_t)tr.z << 12);
+
+    const int16_t components[3] = {v.x, v.y, v.z};
+    for (int i = 0; i < 3; i++) {
+        __m256i column = load(m[0][i], m[1][i], m[2][i]);
+        result = _mm256_add_epi64(result, _mm256_mul_epi32(column, _mm256_set1_epi64x(components[i])));
+        flags |= macOverflow(result);
+        result = extend44(result);
+    }
+    return result;
+}
+};  // namespace simd
+#endif
+
 int32_t GTE::clip(int32_t value, int32_t max, int32_t min, uint32_t flags) {
     if (value > max) {
         flag.reg |= flags;
@@ -87,31 +171,55 @@ void GTE::setMacAndIr(int64_t value, bool lm) {
     setIr<i>(setMac<i>(value), lm);
 }
 
+void GTE::setMacAndIr(Vector<int64_t> value, bool lm) {
+#ifdef __AVX2__
+    __m256i v = simd::load(value.x, value.y, value.z);
+    __m128i result = simd::macValue(v, sf);
+    __m128i min = simd::irMin(lm);
+
+    simd::store(&mac[1], result);
+    simd::store(&ir[1], simd::saturateIr(result, min));
+    flag.reg |= simd::macOverflow(v) | simd::irSaturation(result, min);
+#else
+    setMacAndIr<1>(value.x, lm);
+    setMacAndIr<2>(value.y, lm);
+    setMacAndIr<3>(value.z, lm);
+#endif
+}
+
 void GTE::setOtz(int64_t value) { otz = clip(value >> 12, 0xffff, 0x0000, Flag::SZ3_OTZ_SATURATED); }
 
 #define R (rgbc.read(0) << 4)
 #define G (rgbc.read(1) << 4)
 #define B (rgbc.read(2) << 4)
 
+template <bool hooks>
 void GTE::nclip() {
     int64_t value = (int64_t)s[0].x * s[1].y + s[1].x * s[2].y + s[2].x * s[0].y - s[0].x * s[2].y - s[1].x * s[0].y - s[2].x * s[1].y;
-    Screenshot *screenshot = Screenshot::getInstance();
-    // if (screenshot->getEnabled()) {
-    //        screenshot->originalnclip = value;
-    if (screenshot->doubleSided) {
+    if (hooks && Screenshot::getInstance()->doubleSided) {
         value = std::abs(value);
     }
-    //}
     setMac<0>(value);
 }
 
 void GTE::multiplyVectors(Vector<int16_t> v1, Vector<int16_t> v2, Vector<int16_t> tr) {
-    setMacAndIr<1>(((int64_t)tr.x << 12) + v1.x * v2.x, lm);
-    setMacAndIr<2>(((int64_t)tr.y << 12) + v1.y * v2.y, lm);
-    setMacAndIr<3>(((int64_t)tr.z << 12) + v1.z * v2.z, lm);
+    setMacAndIr(Vector<int64_t>(((int64_t)tr.x << 12) + v1.x * v2.x,  //
+                                ((int64_t)tr.y << 12) + v1.y * v2.y,  //
+                                ((int64_t)tr.z << 12) + v1.z * v2.z),
+                lm);
 }
 
 void GTE::applyMatrix(Matrix m, Vector<int16_t> v, Vector<int32_t> tr) {
+#ifdef __AVX2__
+    // Result is already sign extended to 44 bits, setMac overflow check can be skipped
+    uint32_t flags = 0;
+    __m128i result = simd::macValue(simd::mulMatrixVector(flags, m, v, tr), sf);
+    __m128i min = simd::irMin(lm);
+
+    simd::store(&mac[1], result);
+    simd::store(&ir[1], simd::saturateIr(result, min));
+    flag.reg |= flags | simd::irSaturation(result, min);
+#else
     Vector<int64_t> result;
 
     result.x = O(1, O(1, O(1, ((int64_t)tr.x << 12) + m[0][0] * v.x) + m[0][1] * v.y) + m[0][2] * v.z);
@@ -121,9 +229,28 @@ void GTE::applyMatrix(Matrix m, Vector<int16_t> v, Vector<int32_t> tr) {
     setMacAndIr<1>(result.x, lm);
     setMacAndIr<2>(result.y, lm);
     setMacAndIr<3>(result.z, lm);
+#endif
 }
 
 int64_t GTE::applyMatrixRTP(Matrix m, Vector<int16_t> v, Vector<int32_t> tr) {
+#ifdef __AVX2__
+    uint32_t flags = 0;
+    __m256i product = simd::mulMatrixVector(flags, m, v, tr);
+    __m128i shifted = simd::macValue(product, true);
+    __m128i result = sf ? shifted : simd::truncate(product);
+    __m128i min = simd::irMin(lm);
+
+    // RTP calculates IR3 saturation flag as if lm bit was always false
+    __m128i flagValue = _mm_blend_epi32(result, shifted, 0b0100);
+    __m128i flagMin = _mm_blend_epi32(min, simd::irMin(false), 0b0100);
+
+    // But calculation itself respects lm bit
+    simd::store(&mac[1], result);
+    simd::store(&ir[1], simd::saturateIr(result, min));
+    flag.reg |= flags | simd::irSaturation(flagValue, flagMin);
+
+    return _mm256_extract_epi64(product, 2);
+#else
     Vector<int64_t> result;
 
     result.x = O(1, O(1, O(1, ((int64_t)tr.x << 12) + m[0][0] * v.x) + m[0][1] * v.y) + m[0][2] * v.z);
@@ -141,6 +268,7 @@ int64_t GTE::applyMatrixRTP(Matrix m, Vector<int16_t> v, Vector<int32_t> tr) {
     ir[3] = clip(mac[3], 0x7fff, lm ? 0 : -0x8000);
 
     return result.z;
+#endif
 }
 
 void GTE::ncds(int n) {
@@ -149,13 +277,14 @@ void GTE::ncds(int n) {
 
     auto prevIr = toVector(ir);
 
-    setMacAndIr<1>(((int64_t)farColor.r << 12) - (R * ir[1]));
-    setMacAndIr<2>(((int64_t)farColor.g << 12) - (G * ir[2]));
-    setMacAndIr<3>(((int64_t)farColor.b << 12) - (B * ir[3]));
+    setMacAndIr(Vector<int64_t>(((int64_t)farColor.r << 12) - (R * ir[1]),  //
+                                ((int64_t)farColor.g << 12) - (G * ir[2]),  //
+                                ((int64_t)farColor.b << 12) - (B * ir[3])));
 
-    setMacAndIr<1>((R * prevIr.x) + ir[0] * ir[1], lm);
-    setMacAndIr<2>((G * prevIr.y) + ir[0] * ir[2], lm);
-    setMacAndIr<3>((B * prevIr.z) + ir[0] * ir[3], lm);
+    setMacAndIr(Vector<int64_t>((R * prevIr.x) + ir[0] * ir[1],  //
+                                (G * prevIr.y) + ir[0] * ir[2],  //
+                                (B * prevIr.z) + ir[0] * ir[3]),
+                lm);
     pushColor();
 }
 
@@ -189,13 +318,14 @@ void GTE::cdp() {
 
     auto prevIr = toVector(ir);
 
-    setMacAndIr<1>(((int64_t)farColor.r << 12) - (R * ir[1]));
-    setMacAndIr<2>(((int64_t)farColor.g << 12) - (G * ir[2]));
-    setMacAndIr<3>(((int64_t)farColor.b << 12) - (B * ir[3]));
+    setMacAndIr(Vector<int64_t>(((int64_t)farColor.r << 12) - (R * ir[1]),  //
+                                ((int64_t)farColor.g << 12) - (G * ir[2]),  //
+                                ((int64_t)farColor.b << 12) - (B * ir[3])));
 
-    setMacAndIr<1>((R * prevIr.x) + ir[0] * ir[1], lm);
-    setMacAndIr<2>((G * prevIr.y) + ir[0] * ir[2], lm);
-    setMacAndIr<3>((B * prevIr.z) + ir[0] * ir[3], lm);
+    setMacAndIr(Vector<int64_t>((R * prevIr.x) + ir[0] * ir[1],  //
+                                (G * prevIr.y) + ir[0] * ir[2],  //
+                                (B * prevIr.z) + ir[0] * ir[3]),
+                lm);
     pushColor();
 }
 
@@ -211,27 +341,28 @@ void GTE::ncct() {
     nccs(2);
 }
 
+template <bool hooks>
 void GTE::dpct() {
-    dpcs(true);
-    dpcs(true);
-    dpcs(true);
+    dpcs<hooks>(true);
+    dpcs<hooks>(true);
+    dpcs<hooks>(true);
 }
 
+template <bool hooks>
 void GTE::dpcs(bool useRGB0) {
     // TODO: Change to Color struct
     int16_t r = useRGB0 ? rgb[0].read(0) << 4 : R;
     int16_t g = useRGB0 ? rgb[0].read(1) << 4 : G;
     int16_t b = useRGB0 ? rgb[0].read(2) << 4 : B;
 
-    Screenshot *screenshot = Screenshot::getInstance();
-    if (screenshot->disableFog) {
+    if (hooks && Screenshot::getInstance()->disableFog) {
         setMacAndIr<1>((int64_t)(r << 12));
         setMacAndIr<2>((int64_t)(g << 12));
         setMacAndIr<3>((int64_t)(b << 12));
     } else {
-        setMacAndIr<1>(((int64_t)farColor.r << 12) - (r << 12));
-        setMacAndIr<2>(((int64_t)farColor.g << 12) - (g << 12));
-        setMacAndIr<3>(((int64_t)farColor.b << 12) - (b << 12));
+        setMacAndIr(Vector<int64_t>(((int64_t)farColor.r << 12) - (r << 12),  //
+                                    ((int64_t)farColor.g << 12) - (g << 12),  //
+                                    ((int64_t)farColor.b << 12) - (b << 12)));
         multiplyVectors(Vector<int16_t>(ir[0]), toVector(ir), Vector<int16_t>(r, g, b));
     }
     pushColor();
@@ -240,22 +371,23 @@ void GTE::dpcs(bool useRGB0) {
 void GTE::dcpl() {
     auto prevIr = toVector(ir);
 
-    setMacAndIr<1>(((int64_t)farColor.r << 12) - (R * prevIr.x));
-    setMacAndIr<2>(((int64_t)farColor.g << 12) - (G * prevIr.y));
-    setMacAndIr<3>(((int64_t)farColor.b << 12) - (B * prevIr.z));
+    setMacAndIr(Vector<int64_t>(((int64_t)farColor.r << 12) - (R * prevIr.x),  //
+                                ((int64_t)farColor.g << 12) - (G * prevIr.y),  //
+                                ((int64_t)farColor.b << 12) - (B * prevIr.z)));
 
-    setMacAndIr<1>(R * prevIr.x + ir[0] * ir[1], lm);
-    setMacAndIr<2>(G * prevIr.y + ir[0] * ir[2], lm);
-    setMacAndIr<3>(B * prevIr.z + ir[0] * ir[3], lm);
+    setMacAndIr(Vector<int64_t>(R * prevIr.x + ir[0] * ir[1],  //
+                                G * prevIr.y + ir[0] * ir[2],  //
+                                B * prevIr.z + ir[0] * ir[3]),
+                lm);
     pushColor();
 }
 
 void GTE::intpl() {
     auto prevIr = toVector(ir);
 
-    setMacAndIr<1>(((int64_t)farColor.r << 12) - (prevIr.x << 12));
-    setMacAndIr<2>(((int64_t)farColor.g << 12) - (prevIr.y << 12));
-    setMacAndIr<3>(((int64_t)farColor.b << 12) - (prevIr.z << 12));
+    setMacAndIr(Vector<int64_t>(((int64_t)farColor.r << 12) - (prevIr.x << 12),  //
+                                ((int64_t)farColor.g << 12) - (prevIr.y << 12),  //
+                                ((int64_t)farColor.b << 12) - (prevIr.z << 12)));
 
     multiplyVectors(Vector<int16_t>(ir[0]), toVector(ir), prevIr);
     pushColor();
@@ -273,13 +405,14 @@ int GTE::countLeadingZeroes(uint32_t n) {
 }
 
 size_t GTE::countLeadingZeroes16(uint16_t n) {
-    size_t zeroes = 0;
-
-    while (!(n & 0x8000) && zeroes < 16) {
-        zeroes++;
-        n <<= 1;
-    }
-    return zeroes;
+    if (n == 0) return 16;
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, n);
+    return 15 - index;
+#else
+    return __builtin_clz(n) - 16;
+#endif
 }
 
 uint32_t GTE::divide(uint16_t h, uint16_t sz3) {
@@ -314,14 +447,12 @@ uint32_t GTE::divideUNR(uint32_t lhs, uint32_t rhs) {
     lhs <<= shift;
     rhs <<= shift;
 
-    uint32_t reciprocal = recip(rhs | 0x8000);
+    // Normalized divisor always has bit 15 set, Newton-Raphson steps are precomputed for all of them
+    uint32_t reciprocal = recipTable[rhs & 0x7fff];
 
     uint32_t result = ((uint64_t)lhs * reciprocal + 0x8000) >> 16;
 
-    if (result > 0x1ffff) {
-        return 0x1ffff;
-    }
-    return result;
+    return std::min<uint32_t>(result, 0x1ffff);
 }
 
 void GTE::pushScreenXY(int32_t x, int32_t y) {
@@ -360,6 +491,7 @@ void GTE::pushColor(uint32_t r, uint32_t g, uint32_t b) {
  * Multiplicate vector (V) with rotation matrix (R),
  * translate it (TR) and apply perspective transformation.
  */
+template <bool hooks>
 void GTE::rtps(int n, bool setMAC0, bool fromRTPT) {
     float sx;
     float sy;
@@ -368,9 +500,14 @@ void GTE::rtps(int n, bool setMAC0, bool fromRTPT) {
     int32_t oy;
     int32_t oz;
 
-    
-    Screenshot *screenshot = Screenshot::getInstance();
-    if (screenshot->enabled && screenshot->dontTransform) {
+    Screenshot *screenshot = nullptr;
+    FreeCamera *freeCamera = nullptr;
+    if (hooks) {
+        screenshot = Screenshot::getInstance();
+        freeCamera = FreeCamera::getInstance();
+    }
+
+    if (hooks && screenshot->enabled && screenshot->dontTransform) {
         sx = v[n].x;
         sy = v[n].y;
         sw = v[n].z;
@@ -380,11 +517,10 @@ void GTE::rtps(int n, bool setMAC0, bool fromRTPT) {
     }
 
     int64_t mac3;
-    FreeCamera* free_camera = FreeCamera::getInstance();
-    if (free_camera->enabled) {
+    if (hooks && freeCamera->enabled) {
         Matrix postRotation;
         Vector<int32_t> postTranslation;
-        free_camera->processRotTrans(rotation, translation, &postRotation, &postTranslation);
+        freeCamera->processRotTrans(rotation, translation, &postRotation, &postTranslation);
         mac3 = applyMatrixRTP(postRotation, v[n], postTranslation);
     } else {
         mac3 = applyMatrixRTP(rotation, v[n], translation);
@@ -393,8 +529,8 @@ void GTE::rtps(int n, bool setMAC0, bool fromRTPT) {
     pushScreenZ((int32_t)(mac3 >> 12));
 
     int64_t h_s3z;
-    if (free_camera->enabled) {
-        h_s3z = divideUNR(h + free_camera->translationH, s[3].z);
+    if (hooks && freeCamera->enabled) {
+        h_s3z = divideUNR(h + freeCamera->translationH, s[3].z);
     } else {
         h_s3z = divideUNR(h, s[3].z);
     }
@@ -404,7 +540,7 @@ void GTE::rtps(int n, bool setMAC0, bool fromRTPT) {
     int32_t y = setMac<0>(h_s3z * ir[2] + of[1]) >> 16;
     pushScreenXY(x, y);
 
-    if (screenshot->debug || screenshot->enabled && !screenshot->dontTransform) {
+    if (hooks && (screenshot->debug || screenshot->enabled && !screenshot->dontTransform)) {
         ox = ir[1];
         oy = ir[2];
         oz = s[3].z;
@@ -413,7 +549,7 @@ void GTE::rtps(int n, bool setMAC0, bool fromRTPT) {
         sw = oz;
     }
 
-    if (screenshot->debug || screenshot->enabled) {
+    if (hooks && (screenshot->debug || screenshot->enabled)) {
         if (screenshot->flipX) {
             x = -x;
         }
@@ -448,10 +584,11 @@ void GTE::rtps(int n, bool setMAC0, bool fromRTPT) {
 /**
  * Same as RTPS, but repeated for vector 0, 1 and 2
  */
+template <bool hooks>
 void GTE::rtpt() {
-    rtps(0, false);
-    rtps(1, false);
-    rtps(2, true, true);
+    rtps<hooks>(0, false);
+    rtps<hooks>(1, false);
+    rtps<hooks>(2, true, true);
 }
 
 /**
@@ -542,9 +679,10 @@ void GTE::gpf() {
  * Multiply vector (ir[1..3]) by scalar(ir[0]) and add mac[1..3]
  */
 void GTE::gpl() {
-    setMacAndIr<1>(((int64_t)mac[1] << (sf * 12)) + ir[0] * ir[1], lm);
-    setMacAndIr<2>(((int64_t)mac[2] << (sf * 12)) + ir[0] * ir[2], lm);
-    setMacAndIr<3>(((int64_t)mac[3] << (sf * 12)) + ir[0] * ir[3], lm);
+    setMacAndIr(Vector<int64_t>(((int64_t)mac[1] << (sf * 12)) + ir[0] * ir[1],  //
+                                ((int64_t)mac[2] << (sf * 12)) + ir[0] * ir[2],  //
+                                ((int64_t)mac[3] << (sf * 12)) + ir[0] * ir[3]),
+                lm);
     pushColor();
 }
 
@@ -562,4 +700,16 @@ void GTE::op() {
     setIr<1>(mac[1], lm);
     setIr<2>(mac[2], lm);
     setIr<3>(mac[3], lm);
-}
\ No newline at end of file
+}
+
+// Used by GTE::execute
+template void GTE::nclip<false>();
+template void GTE::nclip<true>();
+template void GTE::dpct<false>();
+template void GTE::dpct<true>();
+template void GTE::dpcs<false>(bool);
+template void GTE::dpcs<true>(bool);
+template void GTE::rtps<false>(int, bool, bool);
+template void GTE::rtps<true>(int, bool, bool);
+template void GTE::rtpt<false>();
+template void GTE::rtpt<true>();
\ No newline at end of file
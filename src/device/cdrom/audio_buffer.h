@@ -0,0 +1,97 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace device::cdrom {
+// Fixed capacity queue of decoded CD-DA and XA samples (44100Hz stereo) waiting to be mixed by the SPU.
+// CDROM and SPU are emulated on the same thread, no synchronization is needed.
+class AudioBuffer {
+   public:
+    using Sample = std::pair<int16_t, int16_t>;
+    inline static const size_t CAPACITY = 16384;  // ~370ms, power of two
+
+   private:
+    std::array<Sample, CAPACITY> data;
+    size_t head = 0;  // Write position, both positions only grow
+    size_t tail = 0;  // Read position
+
+    // Diagnostics, not serialized
+    size_t peak = 0;
+    size_t underruns = 0;  // Buffer ran dry while it was being played
+    size_t overruns = 0;   // Samples dropped because buffer was full
+    bool playing = false;
+
+    static size_t index(size_t pos) { return pos & (CAPACITY - 1); }
+
+   public:
+    size_t size() const { return head - tail; }
+    bool empty() const { return head == tail; }
+    size_t capacity() const { return CAPACITY; }
+
+    size_t getPeak() const { return peak; }
+    size_t getUnderruns() const { return underruns; }
+    size_t getOverruns() const { return overruns; }
+    void resetStats() {
+        peak = size();
+        underruns = 0;
+        overruns = 0;
+    }
+
+    void clear() {
+        tail = head;
+        playing = false;
+    }
+
+    // Returns number of samples written, rest is dropped if buffer is full
+    size_t push(const Sample* src, size_t count) {
+        size_t written = std::min(count, CAPACITY - size());
+        overruns += count - written;
+
+        size_t first = std::min(written, CAPACITY - index(head));
+        std::copy_n(src, first, &data[index(head)]);
+        std::copy_n(src + first, written - first, &data[0]);
+        head += written;
+
+        peak = std::max(peak, size());
+        return written;
+    }
+
+    // Returns number of samples read
+    size_t pop(Sample* dst, size_t count) {
+        size_t read = std::min(count, size());
+        if (read < count && playing) {
+            underruns++;
+        }
+        playing = read == count;
+
+        size_t first = std::min(read, CAPACITY - index(tail));
+        std::copy_n(&data[index(tail)], first, dst);
+        std::copy_n(&data[0], read - first, dst + first);
+        tail += read;
+
+        return read;
+    }
+
+    // Serialized as a sequence of samples
+    template <class Archive>
+    void save(Archive& ar) const {
+        std::vector<Sample> samples(size());
+        for (size_t i = 0; i < samples.size(); i++) {
+            samples[i] = data[index(tail + i)];
+        }
+        ar(samples);
+    }
+
+    template <class Archive>
+    void load(Archive& ar) {
+        std::vector<Sample> samples;
+        ar(samples);
+        head = tail = 0;
+        push(samples.data(), samples.size());
+    }
+};
+}  // namespace device::cdrom
@@ -1,8 +1,11 @@
 #include "cdrom.h"
 #include <fmt/core.h>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include "config.h"
 #include "disc/empty.h"
+#include "disc/track.h"
 #include "sound/adpcm.h"
 #include "system.h"
 #include "utils/bcd.h"
@@ -16,130 +19,197 @@ CDROM::CDROM(System* sys) : sys(sys) {
     disc = std::make_unique<disc::Empty>();
 }
 
-void CDROM::step() {
+CDROM::~CDROM() {
+    if (savedCycles > 0) {
+        fmt::print("[CDROM] Instant disc saved {:.1f}s of emulated loading time\n", getSavedSeconds());
+    }
+}
+
+void CDROM::step(int cycles) {
     status.transmissionBusy = 0;
+
+    const bool spinning = stat.read || stat.play;
+    if (interruptQueue.empty() && !spinning) {
+        return;  // Idle, nothing scheduled
+    }
+
     if (!interruptQueue.empty()) {
-        if ((interruptEnable & 7) & (interruptQueue.peek() & 7)) {
+        if (interruptDelay > 0) {
+            interruptDelay -= cycles;
+        }
+        if (interruptDelay <= 0 && ((interruptEnable & 7) & (interruptQueue.peek().irq & 7))) {
             sys->interrupt->trigger(interrupt::CDROM);
         }
     }
 
-    // TODO: Calculate correct interval using delta cycles
-    int MAGIC_NUMBER = 1150;  // FIXME: yey, magic numbers
-    if (!mode.speed) MAGIC_NUMBER *= 2;
+    if (spinning) {
+        readCycles -= cycles;
+        if (readCycles > 0 && canSkipSectorWait()) {
+            savedCycles += readCycles;
+            readCycles = 0;
+        }
+        if (readCycles <= 0) {
+            readCycles += sectorCycles();
+            readNextSector();
+        }
+    }
+}
 
-    if ((stat.read || stat.play) && readcnt++ == MAGIC_NUMBER) {
-        readcnt = 0;
-        const std::array<uint8_t, 12> sync = {{0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00}};
+int CDROM::seekCycles(int target) {
+    int cycles = MIN_SEEK_CYCLES;
+    if (!stat.motor) {
+        cycles += SPIN_UP_CYCLES;
+    }
 
-        auto pos = disc::Position::fromLba(readSector);
-        std::tie(rawSector, trackType) = disc->read(pos);
-        auto q = disc->getSubQ(pos);
-        if (q.validCrc()) {
-            this->lastQ = q;
-        }
-        readSector++;
+    const int distance = target - readSector;
+    if (distance >= 0 && distance < FINE_SEEK_SECTORS) {
+        // Drive keeps reading and waits until target passes under the head
+        cycles += distance * sectorCycles();
+    } else {
+        int64_t sled = (int64_t)FULL_SEEK_CYCLES * std::min(std::abs(distance), MAX_LBA) / MAX_LBA;
+        cycles += COARSE_SEEK_CYCLES + (int)sled;
+    }
 
-        if (trackType == disc::TrackType::AUDIO && stat.play) {
-            if (!mode.cddaEnable) {
-                return;
-            }
+    if (config.options.emulator.instantDisc) {
+        savedCycles += cycles;
+        return 0;
+    }
+    return cycles;
+}
 
-            if (memcmp(rawSector.data(), sync.data(), sync.size()) == 0) {
-                fmt::print("[CDROM] Trying to read Data track as audio\n");
-                return;
-            }
+bool CDROM::canSkipSectorWait() const {
+    if (!config.options.emulator.instantDisc || !stat.read) return false;
 
-            if (mode.cddaReport) {
-                // Report--> INT1(stat, track, index, mm / amm, ss + 80h / ass, sect / asect, peaklo, peakhi)
-                auto pos = disc::Position::fromLba(readSector);
+    // Previous INT1 wasn't acknowledged yet, the game is still busy with last sector
+    if (!interruptQueue.empty()) return false;
 
-                int track = disc->getTrackByPosition(pos);
+    // INT1 is acknowledged before the data is requested, skipping now would overwrite the sector
+    if (!sectorTaken) return false;
 
-                postInterrupt(1);
-                writeResponse(stat._reg);           // stat
-                writeResponse(bcd::toBcd(track));   // track
-                writeResponse(0x01);                // index
-                writeResponse(bcd::toBcd(pos.mm));  // minute (disc)
-                writeResponse(bcd::toBcd(pos.ss));  // second (disc)
-                writeResponse(bcd::toBcd(pos.ff));  // sector (disc)
-                writeResponse(bcd::toBcd(0));       // peaklo
-                writeResponse(bcd::toBcd(0));       // peakhi
+    // Streamed XA audio and video have to keep the real rate
+    if (rawSector.size() > 18 && static_cast<cd::Submode>(rawSector[18]).realtime) return false;
 
-                if (verbose) {
-                    fmt::print("CDROM: CDDA report -> ({})\n", dumpFifo(CDROM_response));
-                }
-            }
+    return true;
+}
+
+void CDROM::startReading(int target) {
+    // First sector arrives after the seek and one full sector period
+    readCycles = seekCycles(target) + sectorCycles();
+    readSector = target;
+}
 
-            if (!mute) {
-                // Decode Red Book Audio (16bit Stereo 44100Hz)
-                for (size_t i = 0; i < rawSector.size(); i += 4) {
-                    int16_t left = rawSector[i + 0] | (rawSector[i + 1] << 8);
-                    int16_t right = rawSector[i + 2] | (rawSector[i + 3] << 8);
+void CDROM::readNextSector() {
+    const std::array<uint8_t, 12> sync = {{0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00}};
+
+    auto pos = disc::Position::fromLba(readSector);
+    auto sector = disc->read(pos);
+    rawSector.assign(sector.begin(), sector.end());  // Reuses capacity, no allocation after first sector
+    sectorTaken = false;
+    trackType = sector.type;
+    auto q = disc->getSubQ(pos);
+    if (q.validCrc()) {
+        this->lastQ = q;
+    }
+    readSector++;
 
-                    audio.push_back(mixSample(std::make_pair(left, right)));
-                }
+    if (trackType == disc::TrackType::AUDIO && stat.play) {
+        if (!mode.cddaEnable) {
+            return;
+        }
+
+        if (memcmp(rawSector.data(), sync.data(), sync.size()) == 0) {
+            fmt::print("[CDROM] Trying to read Data track as audio\n");
+            return;
+        }
+
+        if (mode.cddaReport) {
+            // Report--> INT1(stat, track, index, mm / amm, ss + 80h / ass, sect / asect, peaklo, peakhi)
+            auto pos = disc::Position::fromLba(readSector);
+
+            int track = disc->getTrackByPosition(pos);
+
+            postInterrupt(1);
+            writeResponse(stat._reg);           // stat
+            writeResponse(bcd::toBcd(track));   // track
+            writeResponse(0x01);                // index
+            writeResponse(bcd::toBcd(pos.mm));  // minute (disc)
+            writeResponse(bcd::toBcd(pos.ss));  // second (disc)
+            writeResponse(bcd::toBcd(pos.ff));  // sector (disc)
+            writeResponse(bcd::toBcd(0));       // peaklo
+            writeResponse(bcd::toBcd(0));       // peakhi
+
+            if (verbose) {
+                fmt::print("CDROM: CDDA report -> ({})\n", dumpFifo(CDROM_response));
             }
-        } else if (trackType == disc::TrackType::DATA && stat.read) {
-            ackMoreData();
+        }
 
-            if (memcmp(rawSector.data(), sync.data(), sync.size()) != 0) {
-                fmt::print("CDROM: Invalid sync\n");
-                return;
+        if (!mute) {
+            // Decode Red Book Audio (16bit Stereo 44100Hz)
+            std::array<AudioBuffer::Sample, disc::Track::SECTOR_SIZE / 4> samples;
+            size_t count = std::min(samples.size(), rawSector.size() / 4);
+            for (size_t i = 0; i < count; i++) {
+                int16_t left = rawSector[i * 4 + 0] | (rawSector[i * 4 + 1] << 8);
+                int16_t right = rawSector[i * 4 + 2] | (rawSector[i * 4 + 3] << 8);
+
+                samples[i] = mixSample(std::make_pair(left, right));
             }
+            audio.push(samples.data(), count);
+        }
+    } else if (trackType == disc::TrackType::DATA && stat.read) {
+        ackMoreData();
 
-            // uint8_t minute = rawSector[12];
-            // uint8_t second = rawSector[13];
-            // uint8_t frame = rawSector[14];
-            uint8_t mode = rawSector[15];
+        if (memcmp(rawSector.data(), sync.data(), sync.size()) != 0) {
+            fmt::print("CDROM: Invalid sync\n");
+            return;
+        }
 
-            uint8_t file = rawSector[16];
-            uint8_t channel = rawSector[17];
-            auto submode = static_cast<cd::Submode>(rawSector[18]);
-            auto codinginfo = static_cast<cd::Codinginfo>(rawSector[19]);
+        // uint8_t minute = rawSector[12];
+        // uint8_t second = rawSector[13];
+        // uint8_t frame = rawSector[14];
+        uint8_t mode = rawSector[15];
+
+        uint8_t file = rawSector[16];
+        uint8_t channel = rawSector[17];
+        auto submode = static_cast<cd::Submode>(rawSector[18]);
+        auto codinginfo = static_cast<cd::Codinginfo>(rawSector[19]);
+
+        // XA uses Mode2 sectors
+        // Does PSX even support Mode1?
+        if (mode != 2) {
+            fmt::print("CDROM: Not mode2 ({} instead)\n", mode);
+            return;
+        }
 
-            // XA uses Mode2 sectors
-            // Does PSX even support Mode1?
-            if (mode != 2) {
-                fmt::print("CDROM: Not mode2 ({} instead)\n", mode);
+        // Only Form2 ?
+        // Does PSX support Form1?
+        // Streaming
+        if (submode.form2 && submode.realtime) {
+            // Filter XA file/channel
+            if (this->mode.xaFilter && (filter.file != file || filter.channel != channel)) {
                 return;
             }
 
-            // Only Form2 ?
-            // Does PSX support Form1?
-            // Streaming
-            if (submode.form2 && submode.realtime) {
-                // Filter XA file/channel
-                if (this->mode.xaFilter && (filter.file != file || filter.channel != channel)) {
-                    return;
-                }
-
-                // Only realtime audio
-                if (!submode.audio || !submode.realtime) {
-                    return;
-                }
-
-                if (codinginfo.bits == 1) {
-                    fmt::print("[CDROM] Unsupported 8bit mode for XA\n");
-                    exit(1);
-                }
+            // Only realtime audio
+            if (!submode.audio || !submode.realtime) {
+                return;
+            }
 
-                if (this->mode.xaEnabled && !this->mute) {
-                    auto frame = ADPCM::decodeXA(rawSector.data() + 24, codinginfo);
+            if (this->mode.xaEnabled && !this->mute) {
+                size_t count = ADPCM::decodeXA(rawSector.data() + 24, codinginfo, xaSamples.data());
 
-                    for (auto sample : frame) {
-                        audio.push_back(mixSample(sample));
-                    }
+                for (size_t i = 0; i < count; i++) {
+                    xaSamples[i] = mixSample(xaSamples[i]);
                 }
+                audio.push(xaSamples.data(), count);
+            }
 
-                if (submode.endOfFile) {
-                    fmt::print("CDROM: End of file\n");
-                    stat.read = false;
-                    return;
-                }
-            } else {
-                // Plain data
+            if (submode.endOfFile) {
+                fmt::print("CDROM: End of file\n");
+                stat.read = false;
+                return;
             }
+        } else {
+            // Plain data
         }
     }
 }
@@ -174,8 +244,8 @@ uint8_t CDROM::read(uint32_t address) {
         }
         if (status.index == 1 || status.index == 3) {  // Interrupt flags
             uint8_t _status = 0b11100000;
-            if (!interruptQueue.empty()) {
-                _status |= interruptQueue.peek() & 7;
+            if (!interruptQueue.empty() && interruptDelay <= 0) {
+                _status |= interruptQueue.peek().irq & 7;
             }
             if (verbose == 2) fmt::print("CDROM: R INTF: 0x{:02x}\n", _status);
             return _status;
@@ -223,6 +293,26 @@ uint8_t CDROM::readByte() {
     return data;
 }
 
+void CDROM::readBlock(uint8_t* dst, size_t size) {
+    const int dataStart = mode.sectorSize ? 12 : 24;
+    const size_t dataSize = mode.sectorSize ? 0x924 : 0x800;
+
+    if (dataBuffer.size() < dataStart + dataSize || dataBufferPointer + size > dataSize) {
+        // Empty buffer or read past the end of data, handled byte by byte
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = readByte();
+        }
+        return;
+    }
+
+    memcpy(dst, dataBuffer.data() + dataStart + dataBufferPointer, size);
+    dataBufferPointer += size;
+
+    if (isBufferEmpty()) {
+        status.dataFifoEmpty = 0;
+    }
+}
+
 std::string CDROM::dumpFifo(const FIFO& f) {
     std::string log = "";
     for (size_t i = 0u; i < f.size(); i++) {
@@ -281,6 +371,9 @@ void CDROM::handleCommand(uint8_t cmd) {
             break;
     }
 
+    // Commands queue their responses right away, first one is delivered after controller processing time
+    interruptDelay = (cmd == 0x0a) ? INIT_RESPONSE_CYCLES : FIRST_RESPONSE_CYCLES;
+
     CDROM_params.clear();
     status.parameterFifoEmpty = 1;
     status.parameterFifoFull = 1;
@@ -312,6 +405,7 @@ void CDROM::write(uint32_t address, uint8_t data) {
             if (isBufferEmpty()) {
                 dataBuffer = rawSector;
                 dataBufferPointer = 0;
+                sectorTaken = true;
                 status.dataFifoEmpty = 1;
             }
         } else {  // clear data fifo
@@ -338,6 +432,9 @@ void CDROM::write(uint32_t address, uint8_t data) {
 
         if (!interruptQueue.empty()) {
             interruptQueue.get();
+            if (!interruptQueue.empty()) {
+                interruptDelay = interruptQueue.peek().delay;
+            }
         }
         if (verbose == 2) fmt::print("CDROM: W INTF: 0x{:02x}\n", data);
         return;
@@ -1,9 +1,11 @@
 #pragma once
+#include <array>
 #include <cassert>
-#include <deque>
 #include <memory>
+#include "audio_buffer.h"
 #include "disc/disc.h"
 #include "fifo.h"
+#include "sound/adpcm.h"
 
 struct System;
 
@@ -104,13 +106,37 @@ class CDROM {
 
     using FIFO = fifo<uint8_t, 16>;
 
+    struct QueuedInterrupt {
+        uint8_t irq;
+        int delay;  // Cycles from acknowledge of the previous interrupt (or from post for the head of queue)
+
+        template <class Archive>
+        void serialize(Archive& ar) {
+            ar(irq, delay);
+        }
+    };
+
+    // Timings in CPU cycles (33.8688 MHz)
+    inline static const int CPU_CLOCK = 33868800;
+    inline static const int FIRST_RESPONSE_CYCLES = 0xc4e1;  // Average INT3 delay
+    inline static const int INIT_RESPONSE_CYCLES = 0x13cce;
+    inline static const int SECOND_RESPONSE_CYCLES = 0x4a00;  // INT2 of GetID, ReadTOC, ...
+    inline static const int STOP_CYCLES = 0x0d38aca;          // Spin down
+    inline static const int STOP_CYCLES_DOUBLE_SPEED = 0x18a6076;
+    inline static const int SPIN_UP_CYCLES = CPU_CLOCK;
+    inline static const int MIN_SEEK_CYCLES = 20000;              // Settling time, even when already on target
+    inline static const int COARSE_SEEK_CYCLES = CPU_CLOCK / 10;  // Sled movement overhead
+    inline static const int FULL_SEEK_CYCLES = CPU_CLOCK;         // Additional time to move the sled across whole disc
+    inline static const int FINE_SEEK_SECTORS = 32;               // Short forward seeks just wait for the sector
+    inline static const int MAX_LBA = 80 * 60 * 75;
+
     int verbose = 1;
 
     CDROM_Status status;
     uint8_t interruptEnable = 0;
     FIFO CDROM_params;
     FIFO CDROM_response;
-    FIFO interruptQueue;
+    fifo<QueuedInterrupt, 16> interruptQueue;
 
     Mode mode;
     Filter filter;
@@ -171,17 +197,36 @@ class CDROM {
         return param;
     }
 
-    void postInterrupt(int irq) {
+    // Interrupt becomes visible to CPU after delay cycles,
+    // for queued interrupts delay counts from acknowledge of the previous one.
+    void postInterrupt(int irq, int delay = 0) {
         assert(irq <= 7);
 
-        interruptQueue.add(irq);
+        if (interruptQueue.empty()) {
+            interruptDelay = delay;
+        }
+        interruptQueue.add({(uint8_t)irq, delay});
     }
 
+    int interruptDelay = 0;    // Cycles until interrupt at the head of queue is visible
+    int readCycles = 0;        // Cycles until next sector is read (valid when reading or playing)
+    bool sectorTaken = false;  // rawSector was copied to dataBuffer by a data request
+
+    uint64_t savedCycles = 0;  // Emulated time skipped in instant disc mode, not serialized
+
+    int sectorCycles() const { return CPU_CLOCK / (mode.speed ? 150 : 75); }
+    int seekCycles(int target);  // Returns 0 in instant disc mode
+    bool canSkipSectorWait() const;
+    void startReading(int target);
+    void readNextSector();
+
     std::string dumpFifo(const FIFO& f);
     std::pair<int16_t, int16_t> mixSample(std::pair<int16_t, int16_t> sample);
 
+    std::array<AudioBuffer::Sample, ADPCM::XA_MAX_SAMPLES> xaSamples;  // Decoded XA sector, not serialized
+
    public:
-    std::deque<std::pair<int16_t, int16_t>> audio;
+    AudioBuffer audio;
     std::vector<uint8_t> rawSector;
 
     std::vector<uint8_t> dataBuffer;
@@ -189,21 +234,23 @@ class CDROM {
 
     bool isBufferEmpty();
     uint8_t readByte();
+    void readBlock(uint8_t* dst, size_t size);  // Same as size readByte() calls
 
-    int readcnt = 0;
     disc::TrackType trackType;
     std::unique_ptr<disc::Disc> disc;
     disc::SubchannelQ lastQ;
     bool mute = false;
 
     CDROM(System* sys);
-    void step();
+    ~CDROM();
+    void step(int cycles);
     uint8_t read(uint32_t address);
     void write(uint32_t address, uint8_t data);
 
     void setShell(bool opened) { stat.setShell(opened); }
     bool getShell() const { return stat.getShell(); }
     void toggleShell() { stat.toggleShell(); }
+    double getSavedSeconds() const { return (double)savedCycles / CPU_CLOCK; }
     void ackMoreData() {
         postInterrupt(1);
         writeResponse(stat._reg);
@@ -226,7 +273,8 @@ class CDROM {
         ar(rawSector);
         ar(dataBuffer);
         ar(dataBufferPointer);
-        ar(readcnt);
+        ar(sectorTaken);
+        ar(interruptDelay, readCycles);
         ar(trackType);
         ar(lastQ);
         ar(mute);
@@ -17,6 +17,7 @@ void CDROM::cmdSetloc() {
     uint8_t sector = bcd::toBinary(readParam());
 
     seekSector = sector + (second * 75) + (minute * 60 * 75);
+    disc->prefetch(disc::Position::fromLba(seekSector), mode.speed ? 2 : 1);
 
     postInterrupt(3);
     writeResponse(stat._reg);
@@ -39,7 +40,7 @@ void CDROM::cmdPlay() {
         pos = disc::Position::fromLba(seekSector);
     }
 
-    readSector = pos.toLba();
+    startReading(pos.toLba());
 
     stat.setMode(StatusCode::Mode::Playing);
 
@@ -50,7 +51,7 @@ void CDROM::cmdPlay() {
 }
 
 void CDROM::cmdReadN() {
-    readSector = seekSector;
+    startReading(seekSector);
 
     stat.setMode(StatusCode::Mode::Reading);
 
@@ -61,37 +62,45 @@ void CDROM::cmdReadN() {
 }
 
 void CDROM::cmdMotorOn() {
+    int delay = stat.motor ? SECOND_RESPONSE_CYCLES : SPIN_UP_CYCLES;
     stat.motor = 1;
 
     postInterrupt(3);
     writeResponse(stat._reg);
 
-    postInterrupt(2);
+    postInterrupt(2, delay);
     writeResponse(stat._reg);
 
     if (verbose) fmt::print("CDROM: cmdMotorOn\n");
 }
 
 void CDROM::cmdStop() {
+    // Spinning down takes longer from double speed
+    int delay = SECOND_RESPONSE_CYCLES;
+    if (stat.motor) delay = mode.speed ? STOP_CYCLES_DOUBLE_SPEED : STOP_CYCLES;
+
     stat.setMode(StatusCode::Mode::None);
     stat.motor = 0;
 
     postInterrupt(3);
     writeResponse(stat._reg);
 
-    postInterrupt(2);
+    postInterrupt(2, delay);
     writeResponse(stat._reg);
 
     if (verbose) fmt::print("CDROM: cmdStop\n");
 }
 
 void CDROM::cmdPause() {
+    // Drive finishes a few sectors before pausing
+    int delay = (stat.read || stat.play) ? 5 * sectorCycles() : SECOND_RESPONSE_CYCLES;
+
     postInterrupt(3);
     writeResponse(stat._reg);
 
     stat.setMode(StatusCode::Mode::None);
 
-    postInterrupt(2);
+    postInterrupt(2, delay);
     writeResponse(stat._reg);
 
     if (verbose) fmt::print("CDROM: cmdPause\n");
@@ -106,7 +115,7 @@ void CDROM::cmdInit() {
 
     mode._reg = 0;
 
-    postInterrupt(2);
+    postInterrupt(2, SECOND_RESPONSE_CYCLES);
     writeResponse(stat._reg);
 
     if (verbose) fmt::print("CDROM: cmdInit\n");
@@ -165,13 +174,14 @@ void CDROM::cmdSetSession() {
     postInterrupt(3);
     writeResponse(stat._reg);
 
-    postInterrupt(2);
+    postInterrupt(2, SECOND_RESPONSE_CYCLES);
     writeResponse(stat._reg);
 
     if (verbose) fmt::print("CDROM: cmdSetSession(0x{:02x})\n", session);
 }
 
 void CDROM::cmdSeekP() {
+    int delay = seekCycles(seekSector);
     readSector = seekSector;
 
     postInterrupt(3);
@@ -179,7 +189,7 @@ void CDROM::cmdSeekP() {
 
     stat.setMode(StatusCode::Mode::Seeking);
 
-    postInterrupt(2);
+    postInterrupt(2, delay);
     writeResponse(stat._reg);
 
     stat.setMode(StatusCode::Mode::None);
@@ -280,6 +290,7 @@ void CDROM::cmdGetTD() {
 }
 
 void CDROM::cmdSeekL() {
+    int delay = seekCycles(seekSector);
     readSector = seekSector;
 
     postInterrupt(3);
@@ -287,7 +298,7 @@ void CDROM::cmdSeekL() {
 
     stat.setMode(StatusCode::Mode::Seeking);
 
-    postInterrupt(2);
+    postInterrupt(2, delay);
     writeResponse(stat._reg);
 
     if (verbose) fmt::print("CDROM: cmdSeekL\n");
@@ -349,20 +360,20 @@ void CDROM::cmdGetId() {
 
     // No CD
     if (disc->getTrackCount() == 0) {
-        postInterrupt(5);
+        postInterrupt(5, SECOND_RESPONSE_CYCLES);
         writeResponse(stat._reg);
         writeResponse(0x40);
         for (int i = 0; i < 6; i++) writeResponse(0);
     }
     // Audio CD
-    else if (disc->read(disc::Position(0, 2, 0)).second == disc::TrackType::AUDIO) {
-        postInterrupt(5);
+    else if (disc->read(disc::Position(0, 2, 0)).type == disc::TrackType::AUDIO) {
+        postInterrupt(5, SECOND_RESPONSE_CYCLES);
         writeResponse(0x0a);
         writeResponse(0x90);
         for (int i = 0; i < 6; i++) writeResponse(0);
     } else {
         // Game CD
-        postInterrupt(2);
+        postInterrupt(2, SECOND_RESPONSE_CYCLES);
         writeResponse(0x02);
         writeResponse(0x00);
         writeResponse(0x20);
@@ -379,7 +390,7 @@ void CDROM::cmdGetId() {
 }
 
 void CDROM::cmdReadS() {
-    readSector = seekSector;
+    startReading(seekSector);
 
     audio.clear();
     stat.setMode(StatusCode::Mode::Reading);
@@ -394,7 +405,7 @@ void CDROM::cmdReadTOC() {
     postInterrupt(3);
     writeResponse(stat._reg);
 
-    postInterrupt(2);
+    postInterrupt(2, SECOND_RESPONSE_CYCLES);
     writeResponse(stat._reg);
 
     if (verbose) fmt::print("CDROM: cmdReadTOC\n");
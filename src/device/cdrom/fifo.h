@@ -39,7 +39,7 @@ class fifo {
 
     T get() {
         if (empty()) {
-            return 0;
+            return {};
             // TODO ?
         }
 
@@ -51,7 +51,7 @@ class fifo {
 
     T peek(const size_t ptr = 0) const {
         if (ptr >= size()) {
-            return 0;
+            return {};
             // TODO ?
         }
 
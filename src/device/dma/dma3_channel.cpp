@@ -1,5 +1,9 @@
 #include "dma3_channel.h"
+#include <fmt/core.h>
+#include <algorithm>
+#include <magic_enum.hpp>
 #include "device/cdrom/cdrom.h"
+#include "system.h"
 #include "utils/file.h"
 
 namespace device::dma {
@@ -12,6 +16,42 @@ uint32_t DMA3Channel::readDevice() {
     return data;
 }
 
+void DMA3Channel::burstTransfer() {
+    uint32_t addr = baseAddress.address & ~3;
+    uint32_t wordCount = count.syncMode0.wordCount;
+    if (wordCount == 0) {
+        wordCount = 0x10000;
+    }
+
+    // Common case - sector data copied straight into main RAM.
+    // Backward step, isolated cache (writes go to icache) and other destinations use the generic path.
+    if (control.direction != CHCR::Direction::toRam || control.memoryAddressStep != CHCR::MemoryAddressStep::forward
+        || addr >= System::RAM_SIZE * 4 || sys->cpu->cop0.status.isolateCache) {
+        DMAChannel::burstTransfer();
+        return;
+    }
+
+    if (verbose && canLog) {
+        fmt::print("[DMA{}] {:<8} -> RAM @ 0x{:08x}, block, count: 0x{:04x}\n", (int)channel, magic_enum::enum_name(channel), addr,
+                   wordCount);
+        canLog = false;
+    }
+
+    // RAM is mirrored, transfer crossing the end of 2MB continues at its beginning
+    size_t size = wordCount * 4;
+    uint32_t offset = addr & (System::RAM_SIZE - 1);
+    while (size > 0) {
+        size_t chunk = std::min<size_t>(size, System::RAM_SIZE - offset);
+        cdrom->readBlock(sys->ram.data() + offset, chunk);
+
+        size -= chunk;
+        offset = 0;
+    }
+
+    irqFlag = true;
+    control.enabled = CHCR::Enabled::completed;
+}
+
 DMA3Channel::DMA3Channel(Channel channel, System* sys, device::cdrom::CDROM* cdrom) : DMAChannel(channel, sys), cdrom(cdrom) {}
 
 }  // namespace device::dma
@@ -10,6 +10,7 @@ class DMA3Channel : public DMAChannel {
     device::cdrom::CDROM* cdrom;
 
     uint32_t readDevice() override;
+    void burstTransfer() override;
 
    public:
     DMA3Channel(Channel channel, System* sys, device::cdrom::CDROM* cdrom);
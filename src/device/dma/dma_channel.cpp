@@ -20,7 +20,6 @@ uint8_t DMAChannel::read(uint32_t address) {
     if (address >= 0x8 && address < 0xc) return control._byte[address - 8];
     return 0;
 }
-static bool canLog = true;
 void DMAChannel::write(uint32_t address, uint8_t data) {
     if (address < 0x4) {
         baseAddress._byte[address] = data;
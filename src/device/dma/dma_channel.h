@@ -89,6 +89,8 @@ class DMAChannel {
 
     System* sys;
 
+    inline static bool canLog = true;  // Log only first transfer after a channel is started (shared by all channels)
+
     virtual uint32_t readDevice();
     virtual void writeDevice(uint32_t data);
     virtual void maskControl();
@@ -853,12 +853,12 @@ void GPU::writeGP1(uint32_t data) {
 bool GPU::emulateGpuCycles(int cycles) {
     gpuDot += cycles;
 
-    int newLines = gpuDot / 3413;
+    int newLines = gpuDot / cyclesPerLine();
     if (newLines == 0) return false;
-    gpuDot %= 3413;
+    gpuDot %= cyclesPerLine();
     gpuLine += newLines;
 
-    if (gpuLine < LINE_VBLANK_START_NTSC - 1) {
+    if (gpuLine < lineVblankStart() - 1) {
         if (gp1_08.verticalResolution == GP1_08::VerticalResolution::r480 && gp1_08.interlace) {
             odd = (frames % 2) != 0;
         } else {
@@ -868,7 +868,7 @@ bool GPU::emulateGpuCycles(int cycles) {
         odd = false;
     }
 
-    if (gpuLine == LINES_TOTAL_NTSC - 1) {
+    if (gpuLine >= linesTotal() - 1) {
         gpuLine = 0;
         frames++;
         return true;
@@ -891,6 +891,12 @@ bool GPU::insideDrawingArea(int x, int y) const {
 
 bool GPU::isNtsc() { return forceNtsc || gp1_08.videoMode == GP1_08::VideoMode::ntsc; }
 
+int GPU::cyclesPerLine() { return isNtsc() ? CYCLES_PER_LINE_NTSC : CYCLES_PER_LINE_PAL; }
+
+int GPU::lineVblankStart() { return isNtsc() ? LINE_VBLANK_START_NTSC : LINE_VBLANK_START_PAL; }
+
+int GPU::linesTotal() { return isNtsc() ? LINES_TOTAL_NTSC : LINES_TOTAL_PAL; }
+
 void GPU::dumpVram(const char* dumpName) {
     std::vector<uint8_t> vram(VRAM_WIDTH * VRAM_HEIGHT * 3);
     for (size_t i = 0; i < this->vram.size(); i++) {
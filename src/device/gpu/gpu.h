@@ -17,9 +17,14 @@ namespace gpu {
 const int VRAM_WIDTH = 1024;
 const int VRAM_HEIGHT = 512;
 
+const int CYCLES_PER_LINE_NTSC = 3413;
 const int LINE_VBLANK_START_NTSC = 243;
 const int LINES_TOTAL_NTSC = 263;
 
+const int CYCLES_PER_LINE_PAL = 3406;
+const int LINE_VBLANK_START_PAL = 288;
+const int LINES_TOTAL_PAL = 314;
+
 class GPU {
     friend struct ::System;
     friend class ::Render;
@@ -143,6 +148,9 @@ class GPU {
     uint32_t read(uint32_t address);
     void write(uint32_t address, uint32_t data);
     bool isNtsc();
+    int cyclesPerLine();
+    int lineVblankStart();
+    int linesTotal();
 
     int minDrawingX(int x) const;
     int minDrawingY(int y) const;
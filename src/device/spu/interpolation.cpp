@@ -1,5 +1,4 @@
 #include "interpolation.h"
-#include <cstdlib>
 namespace {
 std::array<int16_t, 0x200> gauss = {
     {-0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, 0x001,  -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, 0x001,  0x0000,
@@ -36,28 +35,17 @@ std::array<int16_t, 0x200> gauss = {
 };
 
 namespace spu {
-int16_t sample(Voice &v, int p) {
-    if (p < 0) {
-        if (v.prevDecodedSamples.empty()) return 0;
+int16_t sample(Voice &v, int p) { return v.decodedSamples[Voice::HISTORY_SIZE + p]; }
 
-        return v.prevDecodedSamples[v.prevDecodedSamples.size() - std::abs(p)];
-    }
-    return v.decodedSamples[p];
-}
-
-int16_t interpolate(Voice &v, int pos, int i) {
-    // Store two ADPCM rows? zero out if outside?
-    int16_t oldest = sample(v, pos - 3);
-    int16_t older = sample(v, pos - 2);
-    int16_t old = sample(v, pos - 1);
-    int16_t new_ = sample(v, pos);
-
-    int16_t out = 0;
-    out += (gauss[0x0ff - i] * oldest) >> 15;
-    out += (gauss[0x1ff - i] * older) >> 15;
-    out += (gauss[0x100 + i] * old) >> 15;
-    out += (gauss[0x000 + i] * new_) >> 15;
+void loadInterpolation(Mixer &mixer, int lane, Voice &v, int pos, int i) {
+    mixer.samples[0][lane] = sample(v, pos - 3);
+    mixer.samples[1][lane] = sample(v, pos - 2);
+    mixer.samples[2][lane] = sample(v, pos - 1);
+    mixer.samples[3][lane] = sample(v, pos);
 
-    return out;
+    mixer.gauss[0][lane] = gauss[0x0ff - i];
+    mixer.gauss[1][lane] = gauss[0x1ff - i];
+    mixer.gauss[2][lane] = gauss[0x100 + i];
+    mixer.gauss[3][lane] = gauss[0x000 + i];
 }
 }  // namespace spu
\ No newline at end of file
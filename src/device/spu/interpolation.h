@@ -2,5 +2,6 @@
 #include "spu.h"
 
 namespace spu {
-    int16_t interpolate(Voice &v, int pos, int i);
+    // Loads samples around pos and their Gaussian weights into mixer lane
+    void loadInterpolation(Mixer &mixer, int lane, Voice &v, int pos, int i);
 }  // namespace spu
\ No newline at end of file
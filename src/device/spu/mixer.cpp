@@ -0,0 +1,98 @@
+#include "mixer.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace spu {
+namespace {
+// Truncates to int16_t and sign extends back, same as assigning to int16_t
+inline int32_t wrap16(int32_t v) { return (int16_t)v; }
+
+#ifdef __AVX2__
+inline __m256i load(const Mixer::Lanes<int32_t>& lanes, int i) { return _mm256_load_si256((const __m256i*)&lanes[i]); }
+
+inline void store(Mixer::Lanes<int32_t>& lanes, int i, __m256i v) { _mm256_store_si256((__m256i*)&lanes[i], v); }
+
+inline __m256i wrap16(__m256i v) { return _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16); }
+
+// (a * b) >> 15, products of two int16_t values always fit in 32 bits
+inline __m256i mulShift(__m256i a, __m256i b) { return _mm256_srai_epi32(_mm256_mullo_epi32(a, b), 15); }
+#endif
+};  // namespace
+
+Mixer::Mixer() {
+    for (int i = 0; i < 4; i++) {
+        samples[i].fill(0);
+        gauss[i].fill(0);
+    }
+    noise.fill(0);
+    adsrVolume.fill(0);
+    volumeLeft.fill(0);
+    volumeRight.fill(0);
+    reverb.fill(0);
+    output.fill(0);
+    left.fill(0);
+    right.fill(0);
+    reverbLeft.fill(0);
+    reverbRight.fill(0);
+}
+
+void Mixer::process(int16_t noiseLevel) {
+#ifdef __AVX2__
+    static_assert(LANES % 8 == 0, "Lane count must be multiple of AVX2 register width");
+    const __m256i noiseValue = _mm256_set1_epi32(noiseLevel);
+
+    for (int i = 0; i < LANES; i += 8) {
+        // Interpolation accumulates in int16_t, wrapping the sum once is equivalent
+        __m256i interpolated = mulShift(load(gauss[0], i), load(samples[0], i));
+        interpolated = _mm256_add_epi32(interpolated, mulShift(load(gauss[1], i), load(samples[1], i)));
+        interpolated = _mm256_add_epi32(interpolated, mulShift(load(gauss[2], i), load(samples[2], i)));
+        interpolated = _mm256_add_epi32(interpolated, mulShift(load(gauss[3], i), load(samples[3], i)));
+        interpolated = wrap16(interpolated);
+
+        __m256i sample = _mm256_blendv_epi8(interpolated, noiseValue, load(noise, i));
+        sample = wrap16(mulShift(sample, load(adsrVolume, i)));
+        store(output, i, sample);
+
+        __m256i l = wrap16(mulShift(sample, load(volumeLeft, i)));
+        __m256i r = wrap16(mulShift(sample, load(volumeRight, i)));
+        __m256i reverbMask = load(reverb, i);
+        store(left, i, l);
+        store(right, i, r);
+        store(reverbLeft, i, _mm256_and_si256(l, reverbMask));
+        store(reverbRight, i, _mm256_and_si256(r, reverbMask));
+    }
+#else
+    processScalar(noiseLevel);
+#endif
+}
+
+void Mixer::processScalar(int16_t noiseLevel) {
+    for (int i = 0; i < LANES; i++) {
+        int32_t interpolated = 0;
+        for (int j = 0; j < 4; j++) {
+            interpolated += (gauss[j][i] * samples[j][i]) >> 15;
+        }
+        interpolated = wrap16(interpolated);
+
+        int32_t sample = noise[i] ? noiseLevel : interpolated;
+        sample = wrap16((sample * adsrVolume[i]) >> 15);
+        output[i] = sample;
+
+        left[i] = wrap16((sample * volumeLeft[i]) >> 15);
+        right[i] = wrap16((sample * volumeRight[i]) >> 15);
+        reverbLeft[i] = left[i] & reverb[i];
+        reverbRight[i] = right[i] & reverb[i];
+    }
+}
+
+void Mixer::sum(Sample& sumLeft, Sample& sumRight, Sample& sumReverbLeft, Sample& sumReverbRight) const {
+    for (int i = 0; i < LANES; i++) {
+        sumLeft += left[i];
+        sumRight += right[i];
+        sumReverbLeft += reverbLeft[i];
+        sumReverbRight += reverbRight[i];
+    }
+}
+}  // namespace spu
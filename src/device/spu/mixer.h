@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "sample.h"
+
+namespace spu {
+// Voice state needed for producing output samples, in structure-of-arrays form.
+// Gaussian interpolation, ADSR volume and left/right volume are applied to all voices at once,
+// SPU::step fills the lanes and does everything that depends on previous voice (Pitch Modulation).
+struct Mixer {
+    inline static const int LANES = 24;
+    template <typename T>
+    using Lanes = std::array<T, LANES>;
+
+    // Inputs, lanes of voices that are Off or muted have zero volumes
+    alignas(32) Lanes<int32_t> samples[4];  // oldest, older, old, new
+    alignas(32) Lanes<int32_t> gauss[4];    // Interpolation weights for above samples
+    alignas(32) Lanes<int32_t> noise;       // -1 - voice outputs noise instead of interpolated sample
+    alignas(32) Lanes<int32_t> adsrVolume;
+    alignas(32) Lanes<int32_t> volumeLeft;
+    alignas(32) Lanes<int32_t> volumeRight;
+    alignas(32) Lanes<int32_t> reverb;  // -1 - voice is sent to reverb
+
+    // Outputs
+    alignas(32) Lanes<int32_t> output;  // Voice sample after ADSR
+    alignas(32) Lanes<int32_t> left;
+    alignas(32) Lanes<int32_t> right;
+    alignas(32) Lanes<int32_t> reverbLeft;
+    alignas(32) Lanes<int32_t> reverbRight;
+
+    Mixer();
+
+    // Computes outputs for all lanes, AVX2 version if available
+    void process(int16_t noiseLevel);
+    void processScalar(int16_t noiseLevel);
+
+    // Accumulates lanes in voice order, saturation after every voice is kept bit exact
+    void sum(Sample& sumLeft, Sample& sumRight, Sample& sumReverbLeft, Sample& sumReverbRight) const;
+};
+}  // namespace spu
@@ -1,11 +1,14 @@
 #include "reverb.h"
+#include <cstring>
 #include <vector>
 #include "adsr.h"
 #include "sample.h"
 #include "device/device.h"
+#include "spu.h"
 #include "utils/math.h"
 
 namespace spu {
+// Reference implementation, used when current address is outside of work area
 uint32_t wrap(SPU* spu, uint32_t address) {
     const uint32_t reverbBase = spu->reverbBase._reg * 8;
 
@@ -15,30 +18,99 @@ uint32_t wrap(SPU* spu, uint32_t address) {
     return (reverbBase + rel) & 0x7fffe;
 }
 
-void write(SPU* spu, uint32_t address, Sample sample) {
-    uint16_t clamped = sample;
+void ReverbOffsets::update(SPU* spu) {
+    const auto REG = [spu](int r) -> uint32_t {  //
+        return spu->reverbRegisters[r]._reg * 8;
+    };
+
+    base = spu->reverbBase._reg * 8;
+    size = spu->RAM_SIZE - base;
+
+    // Same unsigned arithmetic as in wrap(), offsets below 0 are kept as huge positive values
+    const auto set = [&](Address a, uint32_t offset) {
+        if (offset < 0x80000000) {
+            offsets[a] = {offset % size, 0};
+        } else {
+            offsets[a] = {offset % size, 0 - offset};
+        }
+    };
 
-    uint32_t addr = wrap(spu, spu->reverbCurrentAddress + address);
-    spu->ram[addr + 0] = clamped & 0xff;
-    spu->ram[addr + 1] = (clamped >> 8) & 0xff;
+    set(dLSAME, REG(0x10));
+    set(dRSAME, REG(0x11));
+    set(mLSAME, REG(0x0A));
+    set(mRSAME, REG(0x0B));
+    set(mLSAME_2, REG(0x0A) - 2);
+    set(mRSAME_2, REG(0x0B) - 2);
+    set(dLDIFF, REG(0x18));
+    set(dRDIFF, REG(0x19));
+    set(mLDIFF, REG(0x12));
+    set(mRDIFF, REG(0x13));
+    set(mLDIFF_2, REG(0x12) - 2);
+    set(mRDIFF_2, REG(0x13) - 2);
+    set(mLCOMB1, REG(0x0C));
+    set(mRCOMB1, REG(0x0D));
+    set(mLCOMB2, REG(0x0E));
+    set(mRCOMB2, REG(0x0F));
+    set(mLCOMB3, REG(0x14));
+    set(mRCOMB3, REG(0x15));
+    set(mLCOMB4, REG(0x16));
+    set(mRCOMB4, REG(0x17));
+    set(mLAPF1, REG(0x1A));
+    set(mRAPF1, REG(0x1B));
+    set(mLAPF1_dAPF1, REG(0x1A) - REG(0x00));
+    set(mRAPF1_dAPF1, REG(0x1B) - REG(0x00));
+    set(mLAPF2, REG(0x1C));
+    set(mRAPF2, REG(0x1D));
+    set(mLAPF2_dAPF2, REG(0x1C) - REG(0x01));
+    set(mRAPF2_dAPF2, REG(0x1D) - REG(0x01));
+    set(next, 2);
+
+    dirty = false;
 }
 
-Sample read(SPU* spu, uint32_t address) {
-    uint32_t addr = wrap(spu, spu->reverbCurrentAddress + address);
-    uint16_t data = spu->ram[addr] | (spu->ram[addr + 1] << 8);
-    return data;
+namespace {
+// Equivalent of wrap(spu, current + offset) for current inside of work area (rel < size)
+inline uint32_t resolve(const ReverbOffsets& o, uint32_t rel, ReverbOffsets::Address a) {
+    const auto& offset = o.offsets[a];
+    if (offset.negative != 0 && rel >= offset.negative) {
+        rel -= offset.negative;
+    } else {
+        rel += offset.positive;
+        if (rel >= o.size) rel -= o.size;
+    }
+    return (o.base + rel) & 0x7fffe;
 }
+};  // namespace
 
 std::tuple<int16_t, int16_t> doReverb(SPU* spu, std::tuple<int16_t, int16_t> input) {
+    using A = ReverbOffsets::Address;
     const auto REG = [spu](int r) {  //
         return spu->reverbRegisters[r]._reg;
     };
-    const auto R = [spu](uint32_t addr) {  //
-        return read(spu, addr);
+
+    auto& o = spu->reverbOffsets;
+    if (o.dirty) {
+        o.update(spu);
+    }
+
+    const uint32_t rel = spu->reverbCurrentAddress - o.base;
+    const bool inside = rel < o.size;
+    const uint32_t current = spu->reverbCurrentAddress;
+
+    // Addresses are recomputed with wrap() only when current address is outside of work area (before first wrap)
+    const auto address = [&](A a, uint32_t offset) {
+        if (inside) return resolve(o, rel, a);
+        return wrap(spu, current + offset);
+    };
+    const auto R = [&](A a, uint32_t offset) -> Sample {
+        int16_t data;
+        memcpy(&data, &spu->ram[address(a, offset)], sizeof(data));
+        return data;
     };
-    const auto W = [spu](uint32_t addr, Sample sample) {  //
+    const auto W = [&](A a, uint32_t offset, Sample sample) {
         if (!spu->control.masterReverb) return;
-        return write(spu, addr, sample);
+        int16_t data = sample;
+        memcpy(&spu->ram[address(a, offset)], &data, sizeof(data));
     };
 
     const uint32_t dAPF1 = REG(0x00) * 8;
@@ -77,30 +149,32 @@ std::tuple<int16_t, int16_t> doReverb(SPU* spu, std::tuple<int16_t, int16_t> inp
     Sample Lin = vLIN * std::get<0>(input);
     Sample Rin = vRIN * std::get<1>(input);
 
-    W(mLSAME, (Lin + R(dLSAME) * vWALL - R(mLSAME - 2)) * vIIR + R(mLSAME - 2));
-    W(mRSAME, (Rin + R(dRSAME) * vWALL - R(mRSAME - 2)) * vIIR + R(mRSAME - 2));
+    W(A::mLSAME, mLSAME, (Lin + R(A::dLSAME, dLSAME) * vWALL - R(A::mLSAME_2, mLSAME - 2)) * vIIR + R(A::mLSAME_2, mLSAME - 2));
+    W(A::mRSAME, mRSAME, (Rin + R(A::dRSAME, dRSAME) * vWALL - R(A::mRSAME_2, mRSAME - 2)) * vIIR + R(A::mRSAME_2, mRSAME - 2));
 
-    W(mLDIFF, (Lin + R(dRDIFF) * vWALL - R(mLDIFF - 2)) * vIIR + R(mLDIFF - 2));
-    W(mRDIFF, (Rin + R(dLDIFF) * vWALL - R(mRDIFF - 2)) * vIIR + R(mRDIFF - 2));
+    W(A::mLDIFF, mLDIFF, (Lin + R(A::dRDIFF, dRDIFF) * vWALL - R(A::mLDIFF_2, mLDIFF - 2)) * vIIR + R(A::mLDIFF_2, mLDIFF - 2));
+    W(A::mRDIFF, mRDIFF, (Rin + R(A::dLDIFF, dLDIFF) * vWALL - R(A::mRDIFF_2, mRDIFF - 2)) * vIIR + R(A::mRDIFF_2, mRDIFF - 2));
 
-    Sample Lout = vCOMB1 * R(mLCOMB1) + vCOMB2 * R(mLCOMB2) + vCOMB3 * R(mLCOMB3) + vCOMB4 * R(mLCOMB4);
-    Sample Rout = vCOMB1 * R(mRCOMB1) + vCOMB2 * R(mRCOMB2) + vCOMB3 * R(mRCOMB3) + vCOMB4 * R(mRCOMB4);
+    Sample Lout = vCOMB1 * R(A::mLCOMB1, mLCOMB1) + vCOMB2 * R(A::mLCOMB2, mLCOMB2)  //
+                  + vCOMB3 * R(A::mLCOMB3, mLCOMB3) + vCOMB4 * R(A::mLCOMB4, mLCOMB4);
+    Sample Rout = vCOMB1 * R(A::mRCOMB1, mRCOMB1) + vCOMB2 * R(A::mRCOMB2, mRCOMB2)  //
+                  + vCOMB3 * R(A::mRCOMB3, mRCOMB3) + vCOMB4 * R(A::mRCOMB4, mRCOMB4);
 
-    Lout = Lout - (vAPF1 * R(mLAPF1 - dAPF1));
-    W(mLAPF1, Lout);
-    Lout = Lout * vAPF1 + R(mLAPF1 - dAPF1);
-    Rout = Rout - (vAPF1 * R(mRAPF1 - dAPF1));
-    W(mRAPF1, Rout);
-    Rout = Rout * vAPF1 + R(mRAPF1 - dAPF1);
+    Lout = Lout - (vAPF1 * R(A::mLAPF1_dAPF1, mLAPF1 - dAPF1));
+    W(A::mLAPF1, mLAPF1, Lout);
+    Lout = Lout * vAPF1 + R(A::mLAPF1_dAPF1, mLAPF1 - dAPF1);
+    Rout = Rout - (vAPF1 * R(A::mRAPF1_dAPF1, mRAPF1 - dAPF1));
+    W(A::mRAPF1, mRAPF1, Rout);
+    Rout = Rout * vAPF1 + R(A::mRAPF1_dAPF1, mRAPF1 - dAPF1);
 
-    Lout = Lout - (vAPF2 * R(mLAPF2 - dAPF2));
-    W(mLAPF2, Lout);
-    Lout = Lout * vAPF2 + R(mLAPF2 - dAPF2);
-    Rout = Rout - (vAPF2 * R(mRAPF2 - dAPF2));
-    W(mRAPF2, Rout);
-    Rout = Rout * vAPF2 + R(mRAPF2 - dAPF2);
+    Lout = Lout - (vAPF2 * R(A::mLAPF2_dAPF2, mLAPF2 - dAPF2));
+    W(A::mLAPF2, mLAPF2, Lout);
+    Lout = Lout * vAPF2 + R(A::mLAPF2_dAPF2, mLAPF2 - dAPF2);
+    Rout = Rout - (vAPF2 * R(A::mRAPF2_dAPF2, mRAPF2 - dAPF2));
+    W(A::mRAPF2, mRAPF2, Rout);
+    Rout = Rout * vAPF2 + R(A::mRAPF2_dAPF2, mRAPF2 - dAPF2);
 
-    spu->reverbCurrentAddress = wrap(spu, spu->reverbCurrentAddress + 2);
+    spu->reverbCurrentAddress = address(A::next, 2);
 
     return std::make_tuple(                  //
         Lout * spu->reverbVolume.getLeft(),  //
@@ -1,7 +1,59 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <tuple>
-#include "spu.h"
 
 namespace spu {
+struct SPU;
+
+// Reverb addresses relative to reverbCurrentAddress, already wrapped to work area size.
+// Recalculated only after reverb registers or work area base were changed.
+struct ReverbOffsets {
+    enum Address {
+        dLSAME,
+        dRSAME,
+        mLSAME,
+        mRSAME,
+        mLSAME_2,
+        mRSAME_2,
+        dLDIFF,
+        dRDIFF,
+        mLDIFF,
+        mRDIFF,
+        mLDIFF_2,
+        mRDIFF_2,
+        mLCOMB1,
+        mRCOMB1,
+        mLCOMB2,
+        mRCOMB2,
+        mLCOMB3,
+        mRCOMB3,
+        mLCOMB4,
+        mRCOMB4,
+        mLAPF1,
+        mRAPF1,
+        mLAPF1_dAPF1,
+        mRAPF1_dAPF1,
+        mLAPF2,
+        mRAPF2,
+        mLAPF2_dAPF2,
+        mRAPF2_dAPF2,
+        next,  // reverbCurrentAddress + 2
+        COUNT
+    };
+
+    struct Offset {
+        uint32_t positive;  // offset % size
+        uint32_t negative;  // -offset if offset is negative, 0 otherwise
+    };
+
+    bool dirty = true;
+    uint32_t base;
+    uint32_t size;
+    std::array<Offset, COUNT> offsets;
+
+    void update(SPU* spu);
+};
+
 std::tuple<int16_t, int16_t> doReverb(SPU* spu, std::tuple<int16_t, int16_t> input);
-}  // namespace spu
\ No newline at end of file
+}  // namespace spu
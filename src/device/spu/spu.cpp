@@ -10,37 +10,143 @@
 #include "sound/adpcm.h"
 #include "system.h"
 #include "utils/file.h"
+#include "utils/logic.h"
 #include "utils/math.h"
 #include "config.h"
 
 using namespace spu;
 
 SPU::SPU(System* sys) : sys(sys) {
-    verbose = config.debug.log.spu;
+    busToken = bus.listen<Event::Config::Spu>([&](auto) { reload(); });
+    reload();
     ram.fill(0);
     audioBufferPos = 0;
     captureBufferIndex = 0;
 }
 
-void SPU::step(device::cdrom::CDROM* cdrom) {
+SPU::~SPU() { bus.unlistenAll(busToken); }
+
+void SPU::reload() {
+    verbose = config.debug.log.spu;
+    blockSize = clamp(config.options.sound.blockSize, 1, MAX_BLOCK_SIZE);
+}
+
+void SPU::advance() {
+    if (pendingSamples == 0) {
+        renderPerSample = blockSize == 1 || irqPossible(blockSize);
+    }
+
+    pendingSamples++;
+    if (renderPerSample || pendingSamples >= blockSize) {
+        flush();
+    }
+}
+
+void SPU::flush() {
+    render(pendingSamples);
+    pendingSamples = 0;
+}
+
+void SPU::render(int samples) {
+    std::array<device::cdrom::AudioBuffer::Sample, MAX_BLOCK_SIZE> cd;
+
+    while (samples > 0) {
+        int count = std::min(samples, MAX_BLOCK_SIZE);
+        size_t available = sys->cdrom->audio.pop(cd.data(), count);
+
+        for (int i = 0; i < count; i++) {
+            step(i < (int)available ? &cd[i] : nullptr);
+        }
+        samples -= count;
+    }
+}
+
+// Conservative - checks every address that voices or capture buffers can reach in given number of samples
+bool SPU::irqPossible(int samples) const {
+    if (!control.irqEnable) return false;
+
+    const uint32_t irq = irqAddress._reg * 8;
+
+    // Capture buffers
+    if (irq < 0x1000) return true;
+
+    // Step is limited to 0x4000 - 4 samples per tick, +1 for partially played block and +1 for loop jump
+    const uint32_t reach = 16 * ((samples * 4) / 28 + 2);
+    for (auto& voice : voices) {
+        if (voice.state == Voice::State::Off) continue;
+
+        if (((irq - voice.currentAddress._reg * 8) & (RAM_SIZE - 1)) < reach) return true;
+        if (((irq - voice.repeatAddress._reg * 8) & (RAM_SIZE - 1)) < reach) return true;
+    }
+    return false;
+}
+
+void SPU::updateActiveVoices() {
+    activeVoices = 0;
+    for (int v = 0; v < VOICE_COUNT; v++) {
+        if (voices[v].state != Voice::State::Off) {
+            activeVoices |= 1 << v;
+        } else {
+            // Lanes of inactive voices are not refreshed and must stay silent
+            mixer.volumeLeft[v] = mixer.volumeRight[v] = 0;
+        }
+    }
+}
+
+void SPU::clearAudioBuffer() {
+    recorder.write(audioBuffer.data(), audioBufferPos);
+    audioBufferPos = 0;
+    bufferReady = false;
+}
+
+void SPU::step(const device::cdrom::AudioBuffer::Sample* cdSample) {
     Sample sumLeft = 0, sumReverbLeft = 0;
     Sample sumRight = 0, sumReverbRight = 0;
 
     noise.doNoise(control.noiseFrequencyStep, control.noiseFrequencyShift);
 
-    for (int v = 0; v < VOICE_COUNT; v++) {
+    // Voices are independent up to producing output sample, gather them into mixer lanes.
+    // Voice that ends in this sample is still mixed, its bit is cleared after counters are advanced.
+    const uint32_t active = activeVoices;
+    for (uint32_t mask = active; mask != 0; mask &= mask - 1) {
+        const int v = lowestSetBit(mask);
         Voice& voice = voices[v];
 
-        if (voice.state == Voice::State::Off) continue;
-
-        if (voice.decodedSamples.empty()) {
-            auto block = readBlock(voice.currentAddress._reg * 8);
-            voice.decodedSamples = ADPCM::decode(block.data(), voice.prevSample);
+        if (!voice.blockDecoded) {
+            const uint8_t* block = readBlock(voice.currentAddress._reg * 8);
+            ADPCM::decode(block, voice.prevSample, voice.decodedSamples.data() + Voice::HISTORY_SIZE);
+            voice.blockDecoded = true;
             voice.flagsParsed = false;
         }
 
         voice.processEnvelope();
 
+        // Output is exactly 0 with envelope at 0, Pitch Modulation and capture buffers see the same value.
+        // Voice muted in debugger outputs nothing if its sample is not used anywhere else.
+        const bool outputUsed = v == 1 || v == 3 || (v + 1 < VOICE_COUNT && voices[v + 1].pitchModulation);
+        if (voice.adsrVolume._reg == 0 || (!voice.enabled && !outputUsed)) {
+            mixer.adsrVolume[v] = 0;
+            continue;
+        }
+
+        loadInterpolation(mixer, v, voice, voice.counter.sample, voice.counter.index);
+        mixer.noise[v] = voice.mode == Voice::Mode::Noise ? -1 : 0;
+        mixer.adsrVolume[v] = (int16_t)voice.adsrVolume._reg;
+        mixer.volumeLeft[v] = voice.enabled ? voice.volume.getLeft() : 0;
+        mixer.volumeRight[v] = voice.enabled ? voice.volume.getRight() : 0;
+        mixer.reverb[v] = voice.reverb ? -1 : 0;
+    }
+
+    mixer.process(noise.getNoiseLevel());
+    mixer.sum(sumLeft, sumRight, sumReverbLeft, sumReverbRight);
+
+    // Pitch Modulation uses output of previous voice, counters have to be advanced in order
+    for (uint32_t mask = active; mask != 0; mask &= mask - 1) {
+        const int v = lowestSetBit(mask);
+        Voice& voice = voices[v];
+
+        voice.sample = mixer.output[v];
+
         uint32_t step = voice.sampleRate._reg;
         if (voice.pitchModulation && v > 0) {
             int32_t factor = voices[v - 1].sample + 0x8000;
@@ -49,32 +155,12 @@ void SPU::step(device::cdrom::CDROM* cdrom) {
         }
         if (step > 0x3fff) step = 0x4000;
 
-        Sample sample;
-        if (voice.mode == Voice::Mode::Noise) {
-            sample = noise.getNoiseLevel();
-        } else {
-            sample = interpolate(voice, voice.counter.sample, voice.counter.index);
-        }
-        sample *= voice.adsrVolume._reg;
-        voice.sample = sample;
-
-        if (voice.enabled) {
-            sumLeft += sample * voice.volume.getLeft();
-            sumRight += sample * voice.volume.getRight();
-
-            if (voice.reverb) {
-                sumReverbLeft += sample * voice.volume.getLeft();
-                sumReverbRight += sample * voice.volume.getRight();
-            }
-        }
-
         voice.counter._reg += step;
         if (voice.counter.sample >= 28) {
             // Overflow, parse next ADPCM block
             voice.counter.sample -= 28;
             voice.currentAddress._reg += 2;
-            voice.prevDecodedSamples = voice.decodedSamples;
-            voice.decodedSamples.clear();
+            voice.nextBlock();
 
             if (voice.loadRepeatAddress) {
                 voice.loadRepeatAddress = false;
@@ -85,6 +171,11 @@ void SPU::step(device::cdrom::CDROM* cdrom) {
         if (!voice.flagsParsed) {
             voice.parseFlags(ram[voice.currentAddress._reg * 8 + 1]);
         }
+
+        if (voice.state == Voice::State::Off) {
+            activeVoices &= ~(1 << v);
+            mixer.volumeLeft[v] = mixer.volumeRight[v] = 0;
+        }
     }
 
     if (!control.unmute) {
@@ -95,11 +186,8 @@ void SPU::step(device::cdrom::CDROM* cdrom) {
 
     // Mix with cd
     Sample cdLeft = 0, cdRight = 0;
-    if (!cdrom->audio.empty()) {
-        std::tie(cdLeft, cdRight) = cdrom->audio.front();
-
-        // TODO: Refactor to use ring buffer
-        cdrom->audio.pop_front();
+    if (cdSample != nullptr) {
+        std::tie(cdLeft, cdRight) = *cdSample;
 
         if (control.cdEnable) {
             sumLeft += cdLeft * cdVolume.getLeft();
@@ -126,10 +214,6 @@ void SPU::step(device::cdrom::CDROM* cdrom) {
 
     audioBufferPos += 2;
     if (audioBufferPos >= AUDIO_BUFFER_SIZE) {
-        if (recording) {
-            std::copy(audioBuffer.begin(), audioBuffer.end(), std::back_inserter(recordBuffer));
-        }
-        audioBufferPos = 0;
         bufferReady = true;
     }
 
@@ -217,7 +301,7 @@ void SPU::writeVoice(uint32_t address, uint8_t data) {
         case 6:
         case 7:
             voices[voice].counter._reg = 0;
-            voices[voice].prevDecodedSamples.clear();  // TODO: Not sure is this is what real hardware does
+            voices[voice].clearHistory();  // TODO: Not sure is this is what real hardware does
             voices[voice].startAddress.write(reg - 6, data);
             return;
 
@@ -250,6 +334,8 @@ uint8_t SPU::read(uint32_t address) {
         return data;                                                            \
     }()
 
+    flush();
+
     address += BASE_ADDRESS;
 
     if (verbose) fmt::print("[SPU] R 0x{:08x}\n", address);
@@ -358,6 +444,8 @@ void SPU::write(uint32_t address, uint8_t data) {
         }
     };
 
+    flush();
+
     address += BASE_ADDRESS;
 
     if (address >= 0x1f801c00 && address < 0x1f801c00 + 0x10 * VOICE_COUNT) {
@@ -386,7 +474,10 @@ void SPU::write(uint32_t address, uint8_t data) {
 
     if (address >= 0x1f801d88 && address <= 0x1f801d8b) {  // Voices Key On
         FOR_EACH_VOICE(address - 0x1f801d88, [&](int v, bool bit) {
-            if (control.spuEnable && bit) voices[v].keyOn(sys->cycles);
+            if (control.spuEnable && bit) {
+                voices[v].keyOn(sys->cycles);
+                activeVoices |= 1 << v;
+            }
             if (bit && verbose) fmt::print("[SPU] W Voice {:2d}, KeyOn\n", v + 1);
         });
         return;
@@ -394,7 +485,10 @@ void SPU::write(uint32_t address, uint8_t data) {
 
     if (address >= 0x1f801d8c && address <= 0x1f801d8f) {  // Voices Key Off
         FOR_EACH_VOICE(address - 0x1f801d8c, [&](int v, bool bit) {
-            if (control.spuEnable && bit) voices[v].keyOff(sys->cycles);
+            if (control.spuEnable && bit) {
+                voices[v].keyOff(sys->cycles);
+                if (voices[v].state != Voice::State::Off) activeVoices |= 1 << v;
+            }
             if (bit && verbose) fmt::print("[SPU] W Voice {:2d}, KeyOff\n", v + 1);
         });
         return;
@@ -427,6 +521,7 @@ void SPU::write(uint32_t address, uint8_t data) {
 
     if (address >= 0x1F801DA2 && address <= 0x1F801DA3) {  // Reverb Work area start
         reverbBase.write(address - 0x1F801DA2, data);
+        reverbOffsets.dirty = true;
         if (address == 0x1F801DA3) {
             reverbCurrentAddress = reverbBase._reg * 8;
         }
@@ -487,6 +582,7 @@ void SPU::write(uint32_t address, uint8_t data) {
         auto reg = (address - 0x1F801DC0) / 2;
         auto byte = (address - 0x1F801DC0) % 2;
         reverbRegisters[reg].write(byte, data);
+        reverbOffsets.dirty = true;
         return;
     }
 
@@ -516,15 +612,13 @@ void SPU::memoryWrite16(uint32_t address, uint16_t data) {
     memoryWrite8(address + 1, (uint8_t)(data >> 8));
 }
 
-std::array<uint8_t, 16> SPU::readBlock(uint32_t address) {
+const uint8_t* SPU::readBlock(uint32_t address) {
     if (control.irqEnable && address == irqAddress._reg * 8) {
         status.irqFlag = true;
         sys->interrupt->trigger(interrupt::SPU);
     }
 
-    std::array<uint8_t, 16> buf;
-    std::copy(ram.begin() + address, ram.begin() + address + 16, buf.begin());
-    return buf;
+    return ram.data() + address;
 }
 
 void SPU::dumpRam() {
@@ -1,26 +1,31 @@
 #pragma once
 #include <array>
+#include <vector>
+#include "device/cdrom/audio_buffer.h"
 #include "device/device.h"
+#include "mixer.h"
 #include "noise.h"
 #include "regs.h"
+#include "reverb.h"
 #include "voice.h"
+#include "sound/wave.h"
 
 struct System;
 
-namespace device::cdrom {
-class CDROM;
-}
-
 namespace spu {
 struct SPU {
     static const uint32_t BASE_ADDRESS = 0x1f801c00;
     static const int VOICE_COUNT = 24;
+    static_assert(VOICE_COUNT == Mixer::LANES, "Mixer needs a lane for every voice");
     static const int RAM_SIZE = 1024 * 512;
     static const size_t AUDIO_BUFFER_SIZE = 28 * 2 * 4;
+    static const int MAX_BLOCK_SIZE = 64;
 
+    int busToken;
     int verbose;
 
     std::array<Voice, VOICE_COUNT> voices;
+    uint32_t activeVoices = 0;  // Bit for every voice that is not Off, updated on KeyOn/KeyOff and when envelope ends
 
     Volume mainVolume;
     Volume cdVolume;
@@ -37,6 +42,7 @@ struct SPU {
     uint32_t captureBufferIndex;
 
     Noise noise;
+    Mixer mixer;
 
     Reg32 _keyOn;
     Reg32 _keyOff;
@@ -46,32 +52,47 @@ struct SPU {
     Reg16 reverbBase;
     std::array<Reg16, 32> reverbRegisters;
     uint32_t reverbCurrentAddress;
+    ReverbOffsets reverbOffsets;
     int16_t reverbLeft = 0;
     int16_t reverbRight = 0;
     int reverbCounter = 0;
 
+    // Block rendering - samples are rendered in batches of blockSize,
+    // every register access (CPU or DMA) renders pending samples first
+    int blockSize = 1;
+    int pendingSamples = 0;
+    bool renderPerSample = true;  // SPU IRQ might fire during current block
+
+    // Set when AUDIO_BUFFER_SIZE is reached, rendering continues past it until clearAudioBuffer() is called
     bool bufferReady = false;
     size_t audioBufferPos;
-    std::array<int16_t, AUDIO_BUFFER_SIZE> audioBuffer;
+    std::array<int16_t, AUDIO_BUFFER_SIZE + MAX_BLOCK_SIZE * 2> audioBuffer;
 
     System* sys;
 
     // Debug
-    bool recording;
-    std::vector<uint16_t> recordBuffer;
+    wave::Recorder recorder;
 
     uint8_t readVoice(uint32_t address) const;
     void writeVoice(uint32_t address, uint8_t data);
 
     SPU(System* sys);
-    void step(device::cdrom::CDROM* cdrom);
+    ~SPU();
+    void reload();
+    void step(const device::cdrom::AudioBuffer::Sample* cdSample);  // cdSample is nullptr if no CD audio is available
+    void render(int samples);  // Renders samples immediately, CD audio for all of them is fetched at once
+    void advance();            // Called once per sample period
+    void flush();              // Renders all pending samples
+    bool irqPossible(int samples) const;
+    void updateActiveVoices();
+    void clearAudioBuffer();
     uint8_t read(uint32_t address);
     void write(uint32_t address, uint8_t data);
 
     uint8_t memoryRead8(uint32_t address);
     void memoryWrite8(uint32_t address, uint8_t data);
     void memoryWrite16(uint32_t address, uint16_t data);
-    std::array<uint8_t, 16> readBlock(uint32_t address);
+    const uint8_t* readBlock(uint32_t address);  // Points directly to 16 byte ADPCM block in ram
     void dumpRam();
 
     template <class Archive>
@@ -96,10 +117,14 @@ struct SPU {
         ar(reverbBase);
         ar(reverbRegisters);
         ar(reverbCurrentAddress);
+        reverbOffsets.dirty = true;  // Recalculated from loaded registers
 
+        ar(pendingSamples);
+        ar(renderPerSample);
         ar(bufferReady);
         ar(audioBufferPos);
         ar(audioBuffer);
+        updateActiveVoices();
     }
 };
 }  // namespace spu
\ No newline at end of file
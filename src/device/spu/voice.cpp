@@ -24,6 +24,8 @@ Voice::Voice() {
     loadRepeatAddress = false;
 
     prevSample[0] = prevSample[1] = 0;
+    blockDecoded = false;
+    decodedSamples.fill(0);
 
     enabled = true;
 }
@@ -107,8 +109,15 @@ void Voice::parseFlags(uint8_t flags) {
     }
 }
 
+void Voice::clearHistory() { std::fill_n(decodedSamples.begin(), HISTORY_SIZE, 0); }
+
+void Voice::nextBlock() {
+    std::copy_n(decodedSamples.end() - HISTORY_SIZE, HISTORY_SIZE, decodedSamples.begin());
+    blockDecoded = false;
+}
+
 void Voice::keyOn(uint64_t cycles) {
-    decodedSamples.clear();
+    blockDecoded = false;
     counter.sample = 0;
     adsrVolume._reg = 0;
 
@@ -127,7 +136,7 @@ void Voice::keyOn(uint64_t cycles) {
     adsrWaitCycles = 0;
 
     prevSample[0] = prevSample[1] = 0;
-    prevDecodedSamples.clear();
+    clearHistory();
 
     this->cycles = cycles;
 }
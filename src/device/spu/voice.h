@@ -1,5 +1,5 @@
 #pragma once
-#include <vector>
+#include <array>
 #include "adsr.h"
 #include "device/device.h"
 #include "regs.h"
@@ -43,9 +43,14 @@ struct Voice {
     uint64_t cycles;  // For dismissing KeyOff write right after KeyOn
 
     // ADPCM decoding
+    inline static const int HISTORY_SIZE = 3;  // Gaussian interpolation reaches 3 samples back
     int32_t prevSample[2];
-    std::vector<int16_t> decodedSamples;
-    std::vector<int16_t> prevDecodedSamples;
+    bool blockDecoded;
+    // Last samples of previous block (zeroed if there was none) followed by current block
+    std::array<int16_t, HISTORY_SIZE + 28> decodedSamples;
+
+    void clearHistory();
+    void nextBlock();
 
     Voice();
     Envelope getCurrentPhase();
@@ -75,8 +80,8 @@ struct Voice {
         ar(sample);
         ar(cycles);
         ar(prevSample);
+        ar(blockDecoded);
         ar(decodedSamples);
-        ar(prevDecodedSamples);
     }
 };
 }  // namespace spu
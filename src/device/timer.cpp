@@ -27,8 +27,8 @@ void Timer::step(int cycles) {
         using modes = CounterMode::ClockSource1;
 
         if (clock == modes::hblank) {
-            tval += cnt / 3413;
-            cnt %= 3413;
+            tval += cnt / sys->gpu->cyclesPerLine();
+            cnt %= sys->gpu->cyclesPerLine();
         } else {  // System Clock
             tval += (int)(cnt / 1.5f);
             cnt %= (int)1.5f;
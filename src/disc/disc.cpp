@@ -1,18 +1,53 @@
 #include "disc.h"
 #include <fmt/core.h>
+#include <algorithm>
 #include "utils/file.h"
 
 namespace disc {
 SubchannelQ Disc::getSubQ(Position pos) {
-    if (modifiedQ.find(pos) != modifiedQ.end()) {
-        return modifiedQ[pos];
+    if (!modifiedQ.empty()) {
+        const int lba = pos.toLba();
+        auto it = std::lower_bound(modifiedQ.begin(), modifiedQ.end(), lba, [](const ModifiedQ& e, int lba) { return e.lba < lba; });
+        if (it != modifiedQ.end() && it->lba == lba) {
+            return it->q;
+        }
     }
 
-    TrackType type = read(pos).second;
     int track = getTrackByPosition(pos);
-    auto posInTrack = pos - getTrackStart(track);
+    if (track < 0 || (size_t)track >= getTrackCount()) {
+        // Outside of tracks, no per track state to reuse
+        auto posInTrack = pos - getTrackStart(track);
+        return SubchannelQ::generateForPosition(track, pos, posInTrack, read(pos).type == TrackType::AUDIO);
+    }
+
+    if ((size_t)track >= trackQ.size()) {
+        trackQ.resize(getTrackCount());
+    }
+
+    // Track type and start don't change, sector is read only once per track
+    auto& t = trackQ[track];
+    if (!t.ready) {
+        t.audio = read(pos).type == TrackType::AUDIO;
+        t.start = getTrackStart(track);
+        t.ready = true;
+    }
 
-    return SubchannelQ::generateForPosition(track, pos, posInTrack, type == TrackType::AUDIO);
+    return SubchannelQ::generateForPosition(track, pos, pos - t.start, t.audio);
+}
+
+void Disc::addModifiedQ(std::vector<ModifiedQ> entries) {
+    // Later entries replace earlier ones for the same sector
+    entries.insert(entries.begin(), modifiedQ.begin(), modifiedQ.end());
+    std::stable_sort(entries.begin(), entries.end(), [](const ModifiedQ& a, const ModifiedQ& b) { return a.lba < b.lba; });
+
+    modifiedQ.clear();
+    for (auto& e : entries) {
+        if (!modifiedQ.empty() && modifiedQ.back().lba == e.lba) {
+            modifiedQ.back() = e;
+        } else {
+            modifiedQ.push_back(e);
+        }
+    }
 }
 
 bool Disc::loadSubchannel(const std::string& path) {
@@ -37,6 +72,8 @@ bool Disc::loadLsd(const std::vector<uint8_t>& lsd) {
     const int bytesPerEntry = 15;
     const int count = lsd.size() / bytesPerEntry;
 
+    std::vector<ModifiedQ> entries;
+
     for (int i = 0; i < count; i++) {
         int p = bytesPerEntry * i;
 
@@ -53,8 +90,9 @@ bool Disc::loadLsd(const std::vector<uint8_t>& lsd) {
         }
         q.crc16 = (lsd[p + 12] << 8) | lsd[p + 13];
 
-        modifiedQ[pos] = q;
+        entries.push_back({pos.toLba(), q});
     }
+    addModifiedQ(std::move(entries));
 
     fmt::print("[DISC] Loaded LSD file\n");
     return true;
@@ -75,6 +113,8 @@ bool Disc::loadSbi(const std::vector<uint8_t>& sbi) {
     const int bytesPerEntry = 14;
     const int count = (sbi.size() - headerSize) / bytesPerEntry;
 
+    std::vector<ModifiedQ> entries;
+
     for (int i = 0; i < count; i++) {
         int p = headerSize + bytesPerEntry * i;
 
@@ -97,8 +137,9 @@ bool Disc::loadSbi(const std::vector<uint8_t>& sbi) {
         // Sbi does not include CRC-16, LibCrypt checks only if crc is broken
         q.crc16 = ~q.calculateCrc();
 
-        modifiedQ[pos] = q;
+        entries.push_back({pos.toLba(), q});
     }
+    addModifiedQ(std::move(entries));
 
     fmt::print("[DISC] Loaded SBI file\n");
     return true;
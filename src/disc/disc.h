@@ -1,6 +1,6 @@
 #pragma once
+#include <array>
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 #include "position.h"
 #include "subchannel_q.h"
@@ -9,7 +9,29 @@ namespace disc {
 enum class TrackType { DATA, AUDIO, INVALID };
 typedef std::vector<uint8_t> Data;
 typedef std::vector<uint8_t> Subcode;
-typedef std::pair<Data, TrackType> Sector;
+
+// Zeroed raw sector (Track::SECTOR_SIZE bytes), shared by formats for positions they don't store
+inline constexpr std::array<uint8_t, 2352> ZERO_SECTOR = {};
+
+// Non-owning view of sector data returned by Disc::read.
+// Points to memory owned by the Disc (mapped image or decoded buffer),
+// valid until next read() call on the same Disc.
+struct Sector {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    TrackType type = TrackType::INVALID;
+
+    Sector() = default;
+    Sector(const uint8_t* data, size_t size, TrackType type) : data(data), size(size), type(type) {}
+
+    // View of ZERO_SECTOR
+    static Sector zero() { return {ZERO_SECTOR.data(), ZERO_SECTOR.size(), TrackType::INVALID}; }
+
+    const uint8_t* begin() const { return data; }
+    const uint8_t* end() const { return data + size; }
+    bool empty() const { return size == 0; }
+    uint8_t operator[](size_t i) const { return data[i]; }
+};
 
 struct Disc {
     virtual ~Disc() = default;
@@ -22,11 +44,33 @@ struct Disc {
     virtual Position getTrackLength(int track) const = 0;
     virtual Position getDiskSize() const = 0;
 
-    SubchannelQ getSubQ(Position pos);
+    // Hint that the drive will start reading at pos, speed is 1 or 2 (x150kB/s)
+    virtual void prefetch(Position pos, int speed) {
+        (void)pos;
+        (void)speed;
+    }
+
+    // Q is synthesized from position unless image provides its own (.sbi/.lsd files, inline in .cbin)
+    virtual SubchannelQ getSubQ(Position pos);
     bool loadSubchannel(const std::string& path);
 
    private:
-    std::unordered_map<Position, SubchannelQ> modifiedQ;
+    struct ModifiedQ {
+        int lba;
+        SubchannelQ q;
+    };
+
+    // Q generator state for one track, filled on first access
+    struct TrackQ {
+        bool ready = false;
+        bool audio;
+        Position start;
+    };
+
+    std::vector<ModifiedQ> modifiedQ;  // Sorted by lba, usually a few dozens of LibCrypt sectors
+    std::vector<TrackQ> trackQ;
+
+    void addModifiedQ(std::vector<ModifiedQ> entries);
     bool loadLsd(const std::vector<uint8_t>& lsd);
     bool loadSbi(const std::vector<uint8_t>& sbi);
 };
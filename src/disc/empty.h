@@ -8,7 +8,7 @@ struct Empty : public Disc {
 
     Sector read(Position pos) {
         (void)pos;
-        return std::make_pair(std::vector<uint8_t>(), TrackType::INVALID);
+        return {};
     }
 
     std::string getFile() const { return ""; }
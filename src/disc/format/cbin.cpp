@@ -0,0 +1,510 @@
+#include "cbin.h"
+#include <fmt/core.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "FLAC/stream_decoder.h"
+#include "FLAC/stream_encoder.h"
+#include "LzmaLib.h"
+#include "ecm_sector.h"
+#include "miniz.h"
+#include "utils/file.h"
+
+namespace disc::format {
+namespace {
+const char MAGIC[4] = {'C', 'B', 'I', 'N'};
+const size_t HEADER_SIZE = 20;
+const size_t TRACK_ENTRY_SIZE = 12;
+const std::array<uint8_t, 12> SYNC = {{0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00}};
+const unsigned LZMA_DICT_SIZE = 1 << 16;  // Whole chunk body fits in the dictionary
+
+using Codec = Cbin::Codec;
+using SectorType = Cbin::SectorType;
+
+void put(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out.push_back((value >> (i * 8)) & 0xff);
+    }
+}
+
+uint64_t get(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint64_t)in[i] << (i * 8);
+    }
+    return value;
+}
+
+void putQ(uint8_t* out, SubchannelQ q) {
+    out[0] = q.control.reg;
+    memcpy(out + 1, q.data, sizeof(q.data));
+    out[10] = q.crc16 & 0xff;
+    out[11] = q.crc16 >> 8;
+}
+
+SubchannelQ getQ(const uint8_t* in) {
+    SubchannelQ q;
+    q.control.reg = in[0];
+    memcpy(q.data, in + 1, sizeof(q.data));
+    q.crc16 = in[10] | (in[11] << 8);
+    return q;
+}
+
+// Bytes stored in chunk body, SIZE_MAX for unknown types
+size_t packedSize(SectorType type) {
+    switch (type) {
+        case SectorType::Raw: return Track::SECTOR_SIZE;
+        case SectorType::Mode1: return ecm::inputSize(ecm::Type::Mode1);
+        case SectorType::Mode2Form1:
+        case SectorType::Mode2Form2: return 4 + ecm::inputSize((ecm::Type)type);
+        case SectorType::Empty: return 0;
+        default: return SIZE_MAX;
+    }
+}
+
+void unpackSector(SectorType type, const uint8_t* in, uint8_t* out) {
+    switch (type) {
+        case SectorType::Raw: memcpy(out, in, Track::SECTOR_SIZE); break;
+        case SectorType::Mode1: ecm::decodeSector(ecm::Type::Mode1, in, out); break;
+        case SectorType::Mode2Form1:
+        case SectorType::Mode2Form2:
+            std::copy(SYNC.begin(), SYNC.end(), out);
+            memcpy(out + 0x0c, in, 4);
+            ecm::decodeSector((ecm::Type)type, in + 4, out + 0x10);
+            break;
+        default: memset(out, 0, Track::SECTOR_SIZE); break;
+    }
+}
+
+// Appends sector to chunk body in the smallest form it can be rebuilt from
+SectorType packSector(const uint8_t* sector, std::vector<uint8_t>& body) {
+    SectorType type = SectorType::Raw;
+    std::array<uint8_t, 4 + ecm::inputSize(ecm::Type::Mode2Form2)> packed;
+
+    if (std::equal(SYNC.begin(), SYNC.end(), sector)) {
+        if (sector[0x0f] == 1) {
+            type = SectorType::Mode1;
+            memcpy(packed.data(), sector + 0x0c, 3);
+            memcpy(packed.data() + 3, sector + 0x10, 0x800);
+        } else if (sector[0x0f] == 2 && memcmp(sector + 0x10, sector + 0x14, 4) == 0) {
+            type = (sector[0x12] & 0x20) ? SectorType::Mode2Form2 : SectorType::Mode2Form1;
+            memcpy(packed.data(), sector + 0x0c, 4);
+            memcpy(packed.data() + 4, sector + 0x14, ecm::inputSize((ecm::Type)type));
+        }
+    }
+
+    if (type != SectorType::Raw) {
+        // EDC or ECC that doesn't match the data has to be kept
+        std::array<uint8_t, Track::SECTOR_SIZE> rebuilt;
+        unpackSector(type, packed.data(), rebuilt.data());
+        if (memcmp(rebuilt.data(), sector, Track::SECTOR_SIZE) != 0) {
+            type = SectorType::Raw;
+        }
+    }
+
+    if (type == SectorType::Raw) {
+        body.insert(body.end(), sector, sector + Track::SECTOR_SIZE);
+    } else {
+        body.insert(body.end(), packed.data(), packed.data() + packedSize(type));
+    }
+    return type;
+}
+
+// Compressors return whole chunk starting with codec, or nothing if the codec can't be used
+std::vector<uint8_t> compressLzma(const std::vector<uint8_t>& body, int level) {
+    std::vector<uint8_t> out;
+    out.push_back((uint8_t)Codec::Lzma);
+    put(out, body.size(), 4);
+
+    size_t propsOffset = out.size();
+    size_t propsSize = LZMA_PROPS_SIZE;
+    size_t size = body.size();  // Output larger than body is not worth keeping
+    out.resize(propsOffset + LZMA_PROPS_SIZE + size);
+
+    if (LzmaCompress(&out[propsOffset + LZMA_PROPS_SIZE], &size, body.data(), body.size(), &out[propsOffset], &propsSize, level,
+                     LZMA_DICT_SIZE, -1, -1, -1, -1, 1)
+        != SZ_OK) {
+        return {};
+    }
+    out.resize(propsOffset + LZMA_PROPS_SIZE + size);
+    return out;
+}
+
+FLAC__StreamEncoderWriteStatus flacWrite(const FLAC__StreamEncoder*, const FLAC__byte buffer[], size_t bytes, unsigned, unsigned,
+                                         void* data) {
+    auto out = static_cast<std::vector<uint8_t>*>(data);
+    out->insert(out->end(), buffer, buffer + bytes);
+    return FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+}
+
+// Raw sectors of audio tracks are 16bit stereo little endian samples
+std::vector<uint8_t> compressFlac(const std::vector<uint8_t>& body, int level) {
+    for (int i = 0; i < Cbin::SECTORS_PER_CHUNK; i++) {
+        auto type = (SectorType)body[i];
+        if (type != SectorType::Raw && type != SectorType::Empty) return {};
+    }
+    const size_t samples = (body.size() - Cbin::META_SIZE) / 4;
+    if (samples == 0) return {};
+
+    std::vector<uint8_t> out;
+    out.push_back((uint8_t)Codec::Flac);
+    put(out, body.size(), 4);
+
+    mz_ulong metaSize = mz_compressBound(Cbin::META_SIZE);
+    size_t metaOffset = out.size() + 4;
+    out.resize(metaOffset + metaSize);
+    if (mz_compress2(&out[metaOffset], &metaSize, body.data(), Cbin::META_SIZE, MZ_BEST_COMPRESSION) != MZ_OK) {
+        return {};
+    }
+    out.resize(metaOffset + metaSize);
+    for (int i = 0; i < 4; i++) {
+        out[metaOffset - 4 + i] = (metaSize >> (i * 8)) & 0xff;
+    }
+
+    std::vector<FLAC__int32> pcm(samples * 2);
+    const uint8_t* in = &body[Cbin::META_SIZE];
+    for (size_t i = 0; i < pcm.size(); i++) {
+        pcm[i] = (int16_t)(in[i * 2] | (in[i * 2 + 1] << 8));
+    }
+
+    FLAC__StreamEncoder* encoder = FLAC__stream_encoder_new();
+    if (encoder == nullptr) return {};
+
+    bool ok = FLAC__stream_encoder_set_channels(encoder, 2) && FLAC__stream_encoder_set_bits_per_sample(encoder, 16)
+              && FLAC__stream_encoder_set_sample_rate(encoder, 44100)
+              && FLAC__stream_encoder_set_compression_level(encoder, std::min(level, 8))
+              && FLAC__stream_encoder_set_do_md5(encoder, false) && FLAC__stream_encoder_set_total_samples_estimate(encoder, samples);
+    if (ok && FLAC__stream_encoder_init_stream(encoder, flacWrite, nullptr, nullptr, nullptr, &out) == FLAC__STREAM_ENCODER_INIT_STATUS_OK) {
+        ok = FLAC__stream_encoder_process_interleaved(encoder, pcm.data(), samples);
+        ok = FLAC__stream_encoder_finish(encoder) && ok;  // Flushes last frame
+    } else {
+        ok = false;
+    }
+    FLAC__stream_encoder_delete(encoder);
+
+    if (!ok) return {};
+    return out;
+}
+
+struct FlacStream {
+    const uint8_t* in;
+    size_t inSize;
+    uint8_t* out;
+    size_t outSize;
+    size_t written = 0;
+    bool error = false;
+};
+
+FLAC__StreamDecoderReadStatus flacRead(const FLAC__StreamDecoder*, FLAC__byte buffer[], size_t* bytes, void* data) {
+    auto stream = static_cast<FlacStream*>(data);
+    size_t n = std::min(*bytes, stream->inSize);
+    memcpy(buffer, stream->in, n);
+    stream->in += n;
+    stream->inSize -= n;
+    *bytes = n;
+    return n == 0 ? FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM : FLAC__STREAM_DECODER_READ_STATUS_CONTINUE;
+}
+
+FLAC__StreamDecoderWriteStatus flacWriteSamples(const FLAC__StreamDecoder*, const FLAC__Frame* frame, const FLAC__int32* const buffer[],
+                                                void* data) {
+    auto stream = static_cast<FlacStream*>(data);
+    const size_t samples = frame->header.blocksize;
+    if (frame->header.channels != 2 || frame->header.bits_per_sample != 16 || stream->written + samples * 4 > stream->outSize) {
+        stream->error = true;
+        return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+    }
+
+    uint8_t* out = stream->out + stream->written;
+    for (size_t i = 0; i < samples; i++) {
+        for (int channel = 0; channel < 2; channel++) {
+            int16_t sample = buffer[channel][i];
+            *out++ = sample & 0xff;
+            *out++ = (sample >> 8) & 0xff;
+        }
+    }
+    stream->written += samples * 4;
+    return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+}
+
+void flacError(const FLAC__StreamDecoder*, FLAC__StreamDecoderErrorStatus, void* data) { static_cast<FlacStream*>(data)->error = true; }
+
+bool decompressFlac(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+    FlacStream stream{in, inSize, out, outSize};
+
+    FLAC__StreamDecoder* decoder = FLAC__stream_decoder_new();
+    if (decoder == nullptr) return false;
+
+    bool ok = FLAC__stream_decoder_init_stream(decoder, flacRead, nullptr, nullptr, nullptr, nullptr, flacWriteSamples, nullptr, flacError,
+                                               &stream)
+                  == FLAC__STREAM_DECODER_INIT_STATUS_OK
+              && FLAC__stream_decoder_process_until_end_of_stream(decoder);
+    FLAC__stream_decoder_delete(decoder);
+
+    return ok && !stream.error && stream.written == outSize;
+}
+};  // namespace
+
+std::unique_ptr<Cbin> Cbin::open(const std::string& path) {
+    auto file = MappedFile::open(path);
+    if (!file) {
+        fmt::print("[CBIN] Cannot open {}\n", path);
+        return {};
+    }
+
+    const uint8_t* data = file->data();
+    const size_t size = file->size();
+
+    if (size < HEADER_SIZE || memcmp(data, MAGIC, 4) != 0) {
+        fmt::print("[CBIN] Invalid header\n");
+        return {};
+    }
+    if (get(data + 4, 2) != VERSION || get(data + 6, 2) != SECTORS_PER_CHUNK) {
+        fmt::print("[CBIN] Unsupported version {} (sectors per chunk: {})\n", get(data + 4, 2), get(data + 6, 2));
+        return {};
+    }
+
+    auto cbin = std::unique_ptr<Cbin>(new Cbin());
+    cbin->path = path;
+    cbin->sectorCount = get(data + 8, 4);
+    cbin->diskSize = get(data + 12, 4);
+    uint32_t trackCount = get(data + 16, 4);
+    uint32_t chunkCount = (cbin->sectorCount + SECTORS_PER_CHUNK - 1) / SECTORS_PER_CHUNK;
+
+    size_t tableEnd = HEADER_SIZE + (size_t)trackCount * TRACK_ENTRY_SIZE + (chunkCount + 1) * sizeof(uint64_t);
+    if (tableEnd > size) {
+        fmt::print("[CBIN] File is truncated\n");
+        return {};
+    }
+
+    const uint8_t* p = data + HEADER_SIZE;
+    for (uint32_t i = 0; i < trackCount; i++, p += TRACK_ENTRY_SIZE) {
+        cbin->tracks.push_back({(uint32_t)get(p, 4), (uint32_t)get(p + 4, 4), (TrackType)p[8]});
+    }
+
+    for (uint32_t i = 0; i <= chunkCount; i++, p += sizeof(uint64_t)) {
+        cbin->chunkOffsets.push_back(get(p, sizeof(uint64_t)));
+    }
+    for (uint32_t i = 0; i < chunkCount; i++) {
+        uint64_t begin = cbin->chunkOffsets[i], end = cbin->chunkOffsets[i + 1];
+        if (begin < tableEnd || end < begin || end > size) {
+            fmt::print("[CBIN] Chunk {} is out of file bounds\n", i);
+            return {};
+        }
+    }
+
+    cbin->file = std::move(file);
+    cbin->body.reserve(MAX_BODY_SIZE);
+    cbin->chunk.resize(SECTORS_PER_CHUNK * Track::SECTOR_SIZE);
+    return cbin;
+}
+
+bool Cbin::write(Disc& disc, const std::string& path, int level) {
+    level = std::min(std::max(level, 0), 9);
+    uint32_t diskSize = disc.getDiskSize().toLba();
+    uint32_t sectorCount = diskSize;
+
+    // Tracks follow each other, only start of the first one is taken from the source.
+    // Formats don't agree on getTrackStart() past the first track (Chd returns 00:02:00 for the last one).
+    std::vector<TrackEntry> tracks;
+    uint32_t trackStart = disc.getTrackStart(1).toLba();
+    for (size_t i = 0; i < disc.getTrackCount(); i++) {
+        TrackEntry track;
+        track.start = trackStart;
+        track.frames = disc.getTrackLength(i).toLba();
+        trackStart += track.frames;
+        // Middle of the track, first sector is not matched to a track by every format
+        track.type = disc.read(Position::fromLba(track.start + track.frames / 2)).type;
+
+        tracks.push_back(track);
+        sectorCount = std::max(sectorCount, track.start + track.frames);
+    }
+    uint32_t chunkCount = (sectorCount + SECTORS_PER_CHUNK - 1) / SECTORS_PER_CHUNK;
+
+    std::vector<uint8_t> header(MAGIC, MAGIC + 4);
+    put(header, VERSION, 2);
+    put(header, SECTORS_PER_CHUNK, 2);
+    put(header, sectorCount, 4);
+    put(header, diskSize, 4);
+    put(header, tracks.size(), 4);
+    for (auto& track : tracks) {
+        put(header, track.start, 4);
+        put(header, track.frames, 4);
+        put(header, (uint8_t)track.type, 1);
+        put(header, 0, 3);
+    }
+
+    auto f = unique_ptr_file(fopen(path.c_str(), "wb"));
+    if (!f) {
+        fmt::print("[CBIN] Cannot create {}\n", path);
+        return false;
+    }
+
+    // Offset table is written after all chunks are compressed
+    std::vector<uint64_t> offsets;
+    uint64_t offset = header.size() + (chunkCount + 1) * sizeof(uint64_t);
+    fwrite(header.data(), 1, header.size(), f.get());
+    fseek(f.get(), (long)offset, SEEK_SET);
+
+    std::vector<uint8_t> body;
+    body.reserve(MAX_BODY_SIZE);
+    std::array<uint8_t, Track::SECTOR_SIZE> data;
+
+    // Sectors outside of tracks (pregap of first track) are not read from the source, they are stored as empty
+    auto inTrack = [&tracks](uint32_t lba) {
+        return std::any_of(tracks.begin(), tracks.end(), [lba](const TrackEntry& t) { return lba >= t.start && lba < t.start + t.frames; });
+    };
+
+    for (uint32_t c = 0; c < chunkCount; c++) {
+        body.assign(META_SIZE, 0);
+        for (int i = 0; i < SECTORS_PER_CHUNK; i++) {
+            uint32_t lba = c * SECTORS_PER_CHUNK + i;
+            if (lba >= sectorCount || !inTrack(lba)) {
+                body[i] = (uint8_t)SectorType::Empty;
+                continue;
+            }
+
+            auto pos = Position::fromLba(lba);
+            auto sector = disc.read(pos);
+            data.fill(0);
+            std::copy_n(sector.begin(), std::min<size_t>(sector.size, Track::SECTOR_SIZE), data.begin());
+            auto type = packSector(data.data(), body);
+            body[i] = (uint8_t)type;
+
+            // Reading Q can invalidate the sector view
+            putQ(&body[SECTORS_PER_CHUNK + i * Q_SIZE], disc.getSubQ(pos));
+        }
+
+        // Smallest one wins, chunk is stored as is if no codec helps
+        std::vector<uint8_t> out;
+        out.push_back((uint8_t)Codec::None);
+        out.insert(out.end(), body.begin(), body.end());
+        for (auto& compressed : {compressLzma(body, level), compressFlac(body, level)}) {
+            if (!compressed.empty() && compressed.size() < out.size()) out = compressed;
+        }
+
+        if (fwrite(out.data(), 1, out.size(), f.get()) != out.size()) {
+            fmt::print("[CBIN] Write error\n");
+            return false;
+        }
+        offsets.push_back(offset);
+        offset += out.size();
+    }
+    offsets.push_back(offset);
+
+    std::vector<uint8_t> table;
+    for (auto o : offsets) put(table, o, sizeof(uint64_t));
+    fseek(f.get(), (long)header.size(), SEEK_SET);
+    return fwrite(table.data(), 1, table.size(), f.get()) == table.size();
+}
+
+bool Cbin::loadChunk(uint32_t id) {
+    if (id == chunkId) return true;
+    chunkId = id;
+
+    if (!decompressChunk(file->data() + chunkOffsets[id], chunkOffsets[id + 1] - chunkOffsets[id]) || !unpackChunk()) {
+        fmt::print("[CBIN] Chunk {} is corrupted\n", id);
+        body.assign(META_SIZE, 0);
+        std::fill(chunk.begin(), chunk.end(), 0);
+        return false;
+    }
+    return true;
+}
+
+bool Cbin::decompressChunk(const uint8_t* src, size_t size) {
+    if (size < 1) return false;
+    auto codec = (Codec)src[0];
+    src++;
+    size--;
+
+    if (codec == Codec::None) {
+        if (size < META_SIZE || size > MAX_BODY_SIZE) return false;
+        body.assign(src, src + size);
+        return true;
+    }
+
+    if (size < 4) return false;
+    size_t bodySize = get(src, 4);
+    src += 4;
+    size -= 4;
+    if (bodySize < META_SIZE || bodySize > MAX_BODY_SIZE) return false;
+    body.resize(bodySize);
+
+    if (codec == Codec::Lzma) {
+        if (size < LZMA_PROPS_SIZE) return false;
+        size_t length = bodySize;
+        size_t srcLength = size - LZMA_PROPS_SIZE;
+        return LzmaUncompress(body.data(), &length, src + LZMA_PROPS_SIZE, &srcLength, src, LZMA_PROPS_SIZE) == SZ_OK && length == bodySize;
+    }
+
+    if (codec == Codec::Flac) {
+        if (size < 4) return false;
+        size_t metaSize = get(src, 4);
+        src += 4;
+        size -= 4;
+        if (metaSize > size) return false;
+
+        mz_ulong length = META_SIZE;
+        if (mz_uncompress(body.data(), &length, src, metaSize) != MZ_OK || length != META_SIZE) return false;
+        return decompressFlac(src + metaSize, size - metaSize, body.data() + META_SIZE, bodySize - META_SIZE);
+    }
+
+    return false;
+}
+
+bool Cbin::unpackChunk() {
+    // Packed sizes have to add up to body size, types are not trusted
+    size_t offset = META_SIZE;
+    for (int i = 0; i < SECTORS_PER_CHUNK; i++) {
+        auto type = (SectorType)body[i];
+        size_t size = packedSize(type);
+        if (size > body.size() - offset) return false;
+
+        unpackSector(type, body.data() + offset, &chunk[i * Track::SECTOR_SIZE]);
+        offset += size;
+    }
+    return offset == body.size();
+}
+
+Sector Cbin::read(Position pos) {
+    int track = getTrackByPosition(pos);
+    uint32_t lba = pos.toLba();
+    if (track == -1 || lba >= sectorCount) {
+        return Sector::zero();
+    }
+
+    loadChunk(lba / SECTORS_PER_CHUNK);
+    return {&chunk[(lba % SECTORS_PER_CHUNK) * Track::SECTOR_SIZE], Track::SECTOR_SIZE, tracks[track].type};
+}
+
+SubchannelQ Cbin::getSubQ(Position pos) {
+    uint32_t lba = pos.toLba();
+    if (lba >= sectorCount || getTrackByPosition(pos) == -1) {
+        return Disc::getSubQ(pos);
+    }
+
+    loadChunk(lba / SECTORS_PER_CHUNK);
+    return getQ(&body[SECTORS_PER_CHUNK + (lba % SECTORS_PER_CHUNK) * Q_SIZE]);
+}
+
+int Cbin::getTrackByPosition(Position pos) const {
+    // Tracks are stored back to back, track i covers [start, start + frames)
+    const uint32_t lba = pos.toLba();
+    for (size_t i = 0; i < tracks.size(); i++) {
+        if (lba >= tracks[i].start && lba < tracks[i].start + tracks[i].frames) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+Position Cbin::getTrackStart(int track) const {
+    // Track numbers are 1-based, track 0 is the start of first track, track count + 1 is the end of disc
+    if (tracks.empty()) return Position{0, 0, 0};
+    if (track <= 0) return Position::fromLba(tracks[0].start);
+    if ((size_t)track <= tracks.size()) return Position::fromLba(tracks[track - 1].start);
+    if ((size_t)track == tracks.size() + 1) return Position::fromLba(tracks.back().start + tracks.back().frames);
+    throw std::out_of_range(fmt::format("Track {} out of range", track));
+}
+
+Position Cbin::getTrackLength(int track) const { return Position::fromLba(tracks.at(track).frames); }
+}  // namespace disc::format
@@ -0,0 +1,86 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "disc/disc.h"
+#include "disc/track.h"
+#include "utils/mapped_file.h"
+
+namespace disc::format {
+// Chunked compressed BIN image (.cbin).
+// Groups of SECTORS_PER_CHUNK sectors are compressed separately, chunk offset table gives direct access to any sector.
+// Subchannel Q of every sector is stored in the chunk, so LibCrypt images need no .sbi file.
+//
+// Layout, all values little endian:
+//   "CBIN", u16 version, u16 sectorsPerChunk, u32 sectorCount, u32 diskSize, u32 trackCount
+//   trackCount * (u32 start lba, u32 frames, u8 type, 3 bytes reserved)
+//   (chunkCount + 1) * u64 chunk offset, chunk i spans [offset[i], offset[i + 1])
+//   chunks - u8 codec followed by compressed chunk body (see Codec)
+//
+// Chunk body:
+//   sectorsPerChunk * u8 SectorType, sectorsPerChunk * 12 bytes of Q, then packed sectors back to back.
+//   Data sectors with valid EDC/ECC are stored without sync, EDC and ECC (same as .ecm), which are rebuilt on read.
+struct Cbin : public Disc {
+    static const uint16_t VERSION = 2;
+    static const int SECTORS_PER_CHUNK = 16;
+    static const int Q_SIZE = 12;
+    static const size_t META_SIZE = SECTORS_PER_CHUNK * (1 + Q_SIZE);
+    static const size_t MAX_BODY_SIZE = META_SIZE + SECTORS_PER_CHUNK * Track::SECTOR_SIZE;
+
+    enum class Codec : uint8_t {
+        None = 0,  // body
+        Lzma = 1,  // u32 body size, 5 bytes of LZMA properties, LZMA stream
+        Flac = 2,  // u32 body size, u32 n, n bytes of deflated types and Q, FLAC stream of sectors as 16bit stereo samples
+    };
+
+    // Values up to Mode2Form2 are the same as ecm::Type
+    enum class SectorType : uint8_t {
+        Raw = 0,         // 2352 bytes
+        Mode1 = 1,       // 3 bytes of address, 2048 bytes of data
+        Mode2Form1 = 2,  // 4 bytes of header, 4 bytes of subheader, 2048 bytes of data
+        Mode2Form2 = 3,  // 4 bytes of header, 4 bytes of subheader, 2324 bytes of data
+        Empty = 4,       // Zeroed, nothing stored (outside of tracks)
+    };
+
+    struct TrackEntry {
+        uint32_t start;  // First sector (absolute lba)
+        uint32_t frames;
+        TrackType type;
+    };
+
+    static std::unique_ptr<Cbin> open(const std::string& path);
+
+    // Converts any disc to .cbin, level is LZMA and FLAC compression level (0 - 9).
+    // Each chunk is stored with the codec that makes it smallest, FLAC is tried only for chunks of raw (audio) sectors.
+    static bool write(Disc& disc, const std::string& path, int level = 9);
+
+    Sector read(Position pos) override;
+    SubchannelQ getSubQ(Position pos) override;
+
+    std::string getFile() const override { return path; }
+    size_t getTrackCount() const override { return tracks.size(); }
+    int getTrackByPosition(Position pos) const override;
+    Position getTrackStart(int track) const override;
+    Position getTrackLength(int track) const override;
+    Position getDiskSize() const override { return Position::fromLba(diskSize); }
+
+   private:
+    Cbin() = default;
+
+    std::string path;
+    std::unique_ptr<MappedFile> file;
+    uint32_t sectorCount;
+    uint32_t diskSize;
+    std::vector<TrackEntry> tracks;
+    std::vector<uint64_t> chunkOffsets;
+
+    // Single decompressed chunk, read ahead and caching is left to disc::ReadAhead
+    std::vector<uint8_t> body;   // Decompressed chunk body, Q is read from it
+    std::vector<uint8_t> chunk;  // Unpacked sectors of the chunk
+    uint32_t chunkId = UINT32_MAX;
+
+    bool loadChunk(uint32_t id);
+    bool decompressChunk(const uint8_t* src, size_t size);
+    bool unpackChunk();
+};
+}  // namespace disc::format
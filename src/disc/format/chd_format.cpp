@@ -1,5 +1,6 @@
 #include "chd_format.h"
 #include <fmt/core.h>
+#include <algorithm>
 #include <cstring>
 #include "disc/track.h"
 #include "utils/file.h"
@@ -7,7 +8,7 @@
 namespace disc {
 namespace format {
 
-std::unique_ptr<Chd> Chd::open(const std::string& path) {
+std::unique_ptr<Chd> Chd::open(const std::string& path, int cacheSize, int threads) {
     chd_file* chdFile;
     auto err = chd_open(path.c_str(), CHD_OPEN_READ, nullptr, &chdFile);
     if (err != CHDERR_NONE) {
@@ -20,8 +21,7 @@ std::unique_ptr<Chd> Chd::open(const std::string& path) {
 
     const chd_header* header = chd_get_header(chdFile);
     chd->hunkSize = header->hunkbytes;
-    chd->lastHunk = std::vector<uint8_t>(chd->hunkSize);
-    chd->lastHunkId = 0xfffffff;
+    chd->totalHunks = header->totalhunks;
 
     if ((chd->hunkSize % chd->sectorSize) != 0) {
         fmt::print("[CHD] Image uses invalid hunkSize: {}\n", chd->hunkSize);
@@ -76,27 +76,111 @@ std::unique_ptr<Chd> Chd::open(const std::string& path) {
         chd->tracks.push_back(track);
     }
 
+    std::vector<size_t> frames;
+    for (auto& track : chd->tracks) {
+        frames.push_back(track.frames);
+    }
+    chd->trackTable.build(frames);
     chd->loadSubchannel(path);
 
+    // Hunk being read and the previously returned one must fit next to the pending ones
+    threads = std::max(threads, 0);
+    chd->cache.resize(std::max(cacheSize, threads + 2), chd->hunkSize);
+    chd->startWorkers(threads);
+
     return chd;
 }
 
 Chd::Chd(const std::string& path, chd_file* chdFile) : path(path), chdFile(chdFile) {}
 
-Chd::~Chd() { chd_close(chdFile); }
+Chd::~Chd() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        workerThreadExit = true;
+    }
+    jobCv.notify_all();
+    for (auto& thread : workerThreads) {
+        thread.join();
+    }
+    chd_close(chdFile);
+}
+
+void Chd::startWorkers(int threads) {
+    for (int i = 0; i < threads; i++) {
+        chd_file* file;
+        if (chd_open(path.c_str(), CHD_OPEN_READ, nullptr, &file) != CHDERR_NONE) {
+            break;
+        }
+        workerThreads.emplace_back(&Chd::workerThreadFunc, this, file);
+    }
+    prefetchHunks = (int)workerThreads.size();
+}
+
+void Chd::workerThreadFunc(chd_file* file) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        jobCv.wait(lock, [this] { return workerThreadExit || !jobs.empty(); });
+        if (workerThreadExit) {
+            break;
+        }
+
+        Job job = jobs.front();
+        jobs.pop_front();
+
+        lock.unlock();
+        chd_read(file, job.id, job.hunk->data.data());
+        lock.lock();
+
+        job.hunk->ready = true;
+        pendingHunks--;
+        readyCv.notify_all();
+    }
+    lock.unlock();
+
+    chd_close(file);
+}
 
 Sector Chd::read(Position pos) {
-    int lba = (pos - Position{0, 2, 0}).toLba();
-    size_t hunk = (lba * sectorSize) / hunkSize;
-    size_t offset = (lba * sectorSize) % hunkSize;
+    int lba = pos.toLba() - Position{0, 2, 0}.toLba();
+    if (lba < 0 || (size_t)lba * sectorSize / hunkSize >= totalHunks) {
+        // Pregap before 00:02:00 and sectors past the end are not stored
+        return disc::Sector::zero();
+    }
 
-    if (hunk != lastHunkId || lastHunk.empty()) {
-        chd_read(chdFile, hunk, lastHunk.data());
-        lastHunkId = hunk;
+    size_t hunkId = ((size_t)lba * sectorSize) / hunkSize;
+    size_t offset = ((size_t)lba * sectorSize) % hunkSize;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    Hunk* hunk = cache.find(hunkId);
+    if (hunk == nullptr) {
+        // Miss after a seek, hunks queued for previous position are not needed anymore
+        for (auto& job : jobs) {
+            job.hunk->id = SIZE_MAX;
+            pendingHunks--;
+        }
+        jobs.clear();
+
+        // Decompress on this thread using main handle
+        hunk = cache.allocate(hunkId);
+        lock.unlock();
+        chd_read(chdFile, hunkId, hunk->data.data());
+        lock.lock();
+        hunk->ready = true;
+    } else if (!hunk->ready) {
+        readyCv.wait(lock, [hunk] { return hunk->ready; });
     }
+    cache.touch(hunk);
 
-    std::vector<uint8_t> data(Track::SECTOR_SIZE);
-    std::copy(lastHunk.begin() + offset, lastHunk.begin() + offset + Track::SECTOR_SIZE, data.begin());
+    for (int i = 1; i <= prefetchHunks && pendingHunks < prefetchHunks; i++) {
+        size_t id = hunkId + i;
+        if (id >= totalHunks) break;
+        if (cache.find(id) != nullptr) continue;
+
+        jobs.push_back({cache.allocate(id), id});
+        pendingHunks++;
+        jobCv.notify_one();
+    }
+    lock.unlock();
 
     disc::TrackType type = disc::TrackType::DATA;
 
@@ -105,38 +189,17 @@ Sector Chd::read(Position pos) {
         type = tracks[trackN].type;
     }
 
-    return std::make_pair(data, type);
+    // Points into decompressed hunk, valid until next read
+    return {hunk->data.data() + offset, Track::SECTOR_SIZE, type};
 }
 
 std::string Chd::getFile() const { return path; }
 
 size_t Chd::getTrackCount() const { return tracks.size(); }
 
-int Chd::getTrackByPosition(Position pos) const {
-    size_t posFrames = (pos - Position(0, 2, 0)).toLba();
+int Chd::getTrackByPosition(Position pos) const { return trackTable.trackByPosition(pos); }
 
-    size_t frames = 0;
-    for (size_t i = 0; i < tracks.size(); i++) {
-        if (posFrames > frames && posFrames < frames + tracks[i].frames) {
-            return i;
-        }
-
-        frames += tracks[i].frames;
-    }
-
-    return 0;
-}
-
-Position Chd::getTrackStart(int track) const {
-    size_t frames = 0;
-    if ((unsigned)track < tracks.size()) {
-        for (int i = 0; i < track - 1; i++) {
-            frames += tracks[i].frames;
-        }
-    }
-
-    return Position::fromLba(frames) + Position(0, 2, 0);
-}
+Position Chd::getTrackStart(int track) const { return trackTable.trackStart(track); }
 
 Position Chd::getTrackLength(int track) const {
     if ((unsigned)track < tracks.size()) {
@@ -146,12 +209,6 @@ Position Chd::getTrackLength(int track) const {
     }
 }
 
-Position Chd::getDiskSize() const {
-    size_t frames = 0;
-    for (size_t i = 0; i < tracks.size(); i++) {
-        frames += tracks[i].frames;
-    }
-    return Position::fromLba(frames) + Position(0, 2, 0);
-}
+Position Chd::getDiskSize() const { return trackTable.end(); }
 }  // namespace format
 }  // namespace disc
\ No newline at end of file
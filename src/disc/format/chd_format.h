@@ -1,15 +1,23 @@
 #pragma once
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include "chd.h"
+#include "chd_track_table.h"
 #include "disc/disc.h"
 #include "disc/track.h"
+#include "hunk_cache.h"
 
 namespace disc {
 namespace format {
 struct Chd : public Disc {
     const int sectorSize = Track::SECTOR_SIZE + 96;  // .chd file stores subcode as well, though it is empty
 
-    static std::unique_ptr<Chd> open(const std::string& path);
+    // cacheSize - number of decompressed hunks kept in memory,
+    // threads - number of hunks following the read one decompressed in background, 0 disables it
+    static std::unique_ptr<Chd> open(const std::string& path, int cacheSize = 16, int threads = 2);
 
     ~Chd() override;
 
@@ -29,9 +37,31 @@ struct Chd : public Disc {
     chd_file* chdFile;
     std::vector<Track> tracks;
 
+    ChdTrackTable trackTable;  // Precomputed from tracks
+
     size_t hunkSize;
-    size_t lastHunkId = 0xFFFFFFF;
-    std::vector<uint8_t> lastHunk;
+    size_t totalHunks;
+
+    // Returned Sector points into one of the cached hunks.
+    // Most recently used hunk is never evicted, so the view stays valid until next read.
+    using Hunk = HunkCache::Hunk;
+    HunkCache cache;
+
+    // Workers decompress hunks ahead of reads, each uses its own chd_file handle
+    struct Job {
+        Hunk* hunk;
+        size_t id;
+    };
+    std::mutex mutex;
+    std::condition_variable jobCv;    // Job queued or exit requested
+    std::condition_variable readyCv;  // Hunk decompressed
+    std::deque<Job> jobs;
+    std::vector<std::thread> workerThreads;
+    bool workerThreadExit = false;
+    int prefetchHunks = 0;
+    int pendingHunks = 0;  // Never more than prefetchHunks, cache has room for two more
+    void workerThreadFunc(chd_file* file);
+    void startWorkers(int threads);
 };
 }  // namespace format
 }  // namespace disc
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "disc/position.h"
+
+namespace disc::format {
+// Track layout of .chd image, tracks are stored back to back starting at 00:02:00.
+// Track numbers passed to trackStart are 1-based (0 is treated as 1), trackByPosition returns 0-based index.
+class ChdTrackTable {
+   public:
+    // frames - length of each track in sectors
+    void build(const std::vector<size_t>& frames) {
+        trackFrames.assign(1, 0);
+        for (size_t f : frames) {
+            trackFrames.push_back(trackFrames.back() + f);
+        }
+
+        trackStarts.clear();
+        for (size_t i = 0; i <= frames.size() && !frames.empty(); i++) {
+            trackStarts.push_back(Position::fromLba(trackFrames[i > 0 ? i - 1 : 0]) + Position(0, 2, 0));
+        }
+    }
+
+    size_t count() const { return trackFrames.size() - 1; }
+
+    // Track containing pos, positions outside of tracks are reported as track 0
+    int trackByPosition(Position pos) const {
+        int lba = pos.toLba() - Position(0, 2, 0).toLba();
+        if (lba < 0) return 0;
+
+        // Last track starting at or before lba
+        auto it = std::upper_bound(trackFrames.begin(), trackFrames.end(), (size_t)lba);
+        size_t i = it - trackFrames.begin() - 1;
+        if (i < count() && (size_t)lba < trackFrames[i + 1]) {
+            return i;
+        }
+        return 0;
+    }
+
+    Position trackStart(int track) const {
+        if ((unsigned)track < trackStarts.size()) {
+            return trackStarts[track];
+        }
+        return Position(0, 2, 0);
+    }
+
+    // First position after the last track
+    Position end() const { return Position::fromLba(trackFrames.back()) + Position(0, 2, 0); }
+
+   private:
+    std::vector<size_t> trackFrames = {0};  // First frame of each track (relative to 00:02:00), count() + 1 entries
+    std::vector<Position> trackStarts;      // trackStart result for tracks 0 to count()
+};
+}  // namespace disc::format
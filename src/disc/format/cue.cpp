@@ -1,5 +1,6 @@
 #include "cue.h"
 #include <fmt/core.h>
+#include <stdexcept>
 
 namespace disc {
 namespace format {
@@ -15,60 +16,91 @@ Position Cue::getDiskSize() const {
 
 size_t Cue::getTrackCount() const { return tracks.size(); }
 
-Position Cue::getTrackStart(int track) const {
-    size_t total = 0;
-    if (tracks.at(0).type == disc::TrackType::DATA) {
+void Cue::buildTrackTable() {
+    // Track numbers are 1-based, entry 0 is the start of first track as well. Last entry is the end of disc.
+    trackStarts.resize(tracks.size() + 2);
+
+    int total = 0;
+    if (!tracks.empty() && tracks[0].type == disc::TrackType::DATA) {
         total += 75 * 2;
     }
-    for (int i = 0; i < track - 1; i++) {
-        total += tracks.at(i).frames;
+    trackStarts[0] = total;
+    for (size_t i = 1; i < trackStarts.size(); i++) {
+        trackStarts[i] = total;
+        if (i <= tracks.size()) total += tracks[i - 1].frames;
+    }
+}
+
+Position Cue::getTrackStart(int track) const {
+    if (track <= 0) return Position::fromLba(trackStarts.at(0));
+    if ((size_t)track >= trackStarts.size()) {
+        throw std::out_of_range(fmt::format("Track {} out of range", track));
     }
-    return Position::fromLba(total);
+    return Position::fromLba(trackStarts[track]);
 }
 
 Position Cue::getTrackLength(int track) const { return Position::fromLba(tracks.at(track).frames); }
 
 int Cue::getTrackByPosition(Position pos) const {
-    for (size_t i = 0; i < getTrackCount(); i++) {
-        auto start = getTrackStart(i);
-        auto size = tracks[i].frames;
-
-        if (pos >= start && pos < start + Position::fromLba(size)) {
+    // Ranges are checked in order and can overlap (track i starts at getTrackStart(i)), first match wins
+    const int lba = pos.toLba();
+    for (size_t i = 0; i < tracks.size(); i++) {
+        if (lba >= trackStarts[i] && lba < trackStarts[i] + (int)tracks[i].frames) {
             return i;
         }
     }
     return -1;
 }
 
-disc::Sector Cue::read(Position pos) {
-    auto buffer = std::vector<uint8_t>(Track::SECTOR_SIZE);
-    auto type = disc::TrackType::INVALID;
+disc::Sector Cue::readToBuffer(const Track& track, int64_t offset) {
+    buffer.fill(0);
 
-    auto trackNum = getTrackByPosition(pos);
-    if (trackNum != -1) {
-        auto track = tracks[trackNum];
-        if (files.find(track.filename) == files.end()) {
-            auto f = unique_ptr_file(fopen(track.filename.c_str(), "rb"));
-            if (!f) {
-                fmt::print("Unable to load file {}\n", track.filename);
-                return std::make_pair(buffer, type);
-            }
-
-            files.emplace(track.filename, std::move(f));
+    auto mapped = mappedFiles.find(track.filename);
+    if (mapped == mappedFiles.end()) {
+        mapped = mappedFiles.emplace(track.filename, MappedFile::open(track.filename)).first;
+    }
+
+    if (auto& map = mapped->second) {
+        if (offset >= 0 && (uint64_t)offset + Track::SECTOR_SIZE <= map->size()) {
+            return {map->data() + offset, Track::SECTOR_SIZE, track.type};
         }
 
-        type = track.type;
-        auto file = files[track.filename].get();
+        // Partial sector at the end of file
+        if (offset >= 0 && (uint64_t)offset < map->size()) {
+            std::copy(map->data() + offset, map->data() + map->size(), buffer.begin());
+        }
+        return {buffer.data(), buffer.size(), track.type};
+    }
 
-        if (trackNum == 0 && type == disc::TrackType::DATA) {
-            pos = pos - Position{0, 2, 0};
+    if (files.find(track.filename) == files.end()) {
+        auto f = unique_ptr_file(fopen(track.filename.c_str(), "rb"));
+        if (!f) {
+            fmt::print("Unable to load file {}\n", track.filename);
+            return {buffer.data(), buffer.size(), disc::TrackType::INVALID};
         }
-        auto seek = pos - *track.index0;
-        fseek(file, (long)(track.offset + seek.toLba() * Track::SECTOR_SIZE), SEEK_SET);
-        fread(buffer.data(), Track::SECTOR_SIZE, 1, file);
+
+        files.emplace(track.filename, std::move(f));
+    }
+
+    auto file = files[track.filename].get();
+    fseek(file, (long)offset, SEEK_SET);
+    fread(buffer.data(), Track::SECTOR_SIZE, 1, file);
+    return {buffer.data(), buffer.size(), track.type};
+}
+
+disc::Sector Cue::read(Position pos) {
+    auto trackNum = getTrackByPosition(pos);
+    if (trackNum == -1) {
+        buffer.fill(0);
+        return {buffer.data(), buffer.size(), disc::TrackType::INVALID};
     }
 
-    return std::make_pair(buffer, type);
+    const auto& track = tracks[trackNum];
+    if (trackNum == 0 && track.type == disc::TrackType::DATA) {
+        pos = pos - Position{0, 2, 0};
+    }
+    auto seek = pos - *track.index0;
+    return readToBuffer(track, (int64_t)track.offset + (int64_t)seek.toLba() * Track::SECTOR_SIZE);
 }
 
 std::unique_ptr<Cue> Cue::fromBin(const char* file) {
@@ -90,6 +122,7 @@ std::unique_ptr<Cue> Cue::fromBin(const char* file) {
     auto cue = std::make_unique<Cue>();
     cue->file = file;
     cue->tracks.push_back(t);
+    cue->buildTrackTable();
 
     cue->loadSubchannel(file);
 
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <cstdio>
 #include <memory>
 #include <optional>
@@ -8,6 +9,7 @@
 #include "disc/position.h"
 #include "disc/track.h"
 #include "utils/file.h"
+#include "utils/mapped_file.h"
 
 namespace disc {
 namespace format {
@@ -16,9 +18,12 @@ struct Cue : public Disc {
     std::vector<Track> tracks;
 
     Cue() = default;
-    Cue(Cue& cue) : file(cue.file), tracks(cue.tracks) {}
+    Cue(Cue& cue) : file(cue.file), tracks(cue.tracks) { buildTrackTable(); }
     static std::unique_ptr<Cue> fromBin(const char* file);
 
+    // Must be called after tracks are modified
+    void buildTrackTable();
+
     std::string getFile() const override;
     Position getDiskSize() const override;
     size_t getTrackCount() const override;
@@ -29,7 +34,15 @@ struct Cue : public Disc {
     disc::Sector read(Position pos) override;
 
    private:
+    std::vector<int> trackStarts;  // getTrackStart() in LBA for every track number
+
+    // Track files are memory mapped, read() returns pointer into the mapping.
+    // If mapping fails (e.g. address space exhausted) sectors are read to buffer.
+    std::unordered_map<std::string, std::unique_ptr<MappedFile>> mappedFiles;
     std::unordered_map<std::string, unique_ptr_file> files;
+    std::array<uint8_t, Track::SECTOR_SIZE> buffer;
+
+    disc::Sector readToBuffer(const Track& track, int64_t offset);
 };
 }  // namespace format
 }  // namespace disc
@@ -1,32 +1,93 @@
 #include "ecm.h"
-#include <utility>
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <utility>
 
 namespace disc::format {
-Ecm::Ecm(std::string file, std::vector<uint8_t> data) : file(std::move(file)), data(std::move(data)) {}
+Ecm::Ecm(std::string file, std::vector<Run> runs, uint64_t size) : file(std::move(file)), runs(std::move(runs)), size(size) {
+    mapped = MappedFile::open(this->file);
+    if (!mapped) {
+        f = unique_ptr_file(fopen(this->file.c_str(), "rb"));
+    }
+}
+
+const uint8_t* Ecm::fileData(uint64_t offset, size_t size, uint8_t* buffer) {
+    if (mapped) {
+        return mapped->data() + offset;
+    }
+
+    memset(buffer, 0, size);
+    if (f) {
+        fseek(f.get(), (long)offset, SEEK_SET);
+        fread(buffer, 1, size, f.get());
+    }
+    return buffer;
+}
+
+void Ecm::decode(uint64_t offset, uint8_t* dst, size_t size) {
+    // Last run starting at or before offset
+    auto run = std::upper_bound(runs.begin(), runs.end(), offset, [](uint64_t o, const Run& r) { return o < r.offset; });
+    if (run != runs.begin()) --run;
+
+    uint8_t input[ecm::inputSize(ecm::Type::Mode2Form2)];
+    uint8_t sector[Track::SECTOR_SIZE];
+
+    for (; size > 0 && run != runs.end(); ++run) {
+        const size_t unit = ecm::outputSize(run->type);
+        const uint64_t runSize = (uint64_t)run->count * unit;
+
+        while (size > 0 && offset - run->offset < runSize) {
+            uint64_t pos = offset - run->offset;
+            size_t n;
+
+            if (run->type == ecm::Type::Raw) {
+                n = (size_t)std::min<uint64_t>(size, runSize - pos);
+                const uint8_t* data = fileData(run->fileOffset + pos, n, dst);
+                if (data != dst) memcpy(dst, data, n);
+            } else {
+                uint64_t index = pos / unit;
+                size_t within = pos % unit;
+                size_t inputSize = ecm::inputSize(run->type);
+
+                ecm::decodeSector(run->type, fileData(run->fileOffset + index * inputSize, inputSize, input), sector);
+                n = std::min(size, unit - within);
+                memcpy(dst, sector + within, n);
+            }
+
+            dst += n;
+            offset += n;
+            size -= n;
+        }
+    }
+
+    memset(dst, 0, size);
+}
 
 std::string Ecm::getFile() const { return file; }
 
-disc::Position Ecm::getDiskSize() const { return disc::Position::fromLba(data.size() / Track::SECTOR_SIZE); }
+disc::Position Ecm::getDiskSize() const { return disc::Position::fromLba(size / Track::SECTOR_SIZE); }
 
 size_t Ecm::getTrackCount() const { return 1; }
 
 disc::Position Ecm::getTrackStart(int track) const { return disc::Position(0, 2, 0); }
 
-disc::Position Ecm::getTrackLength(int track) const { return disc::Position::fromLba(data.size() / Track::SECTOR_SIZE); }
+disc::Position Ecm::getTrackLength(int track) const { return disc::Position::fromLba(size / Track::SECTOR_SIZE); }
 
 int Ecm::getTrackByPosition(disc::Position pos) const { return 1; }
 
 disc::Sector Ecm::read(disc::Position pos) {
-    std::vector<uint8_t> sector(Track::SECTOR_SIZE);
-
-    size_t lba = (pos - disc::Position(0, 2, 0)).toLba() * Track::SECTOR_SIZE;
-    if (lba + Track::SECTOR_SIZE >= data.size()) {
-        return std::make_pair(sector, TrackType::INVALID);
+    size_t lba = (pos - disc::Position(0, 2, 0)).toLba();
+    if (lba >= size / Track::SECTOR_SIZE) {
+        return Sector::zero();
     }
 
-    std::copy(data.begin() + lba, data.begin() + lba + Track::SECTOR_SIZE, sector.begin());
+    auto& cached = cache[lba % CACHE_SIZE];
+    if (cached.lba != lba) {
+        decode((uint64_t)lba * Track::SECTOR_SIZE, cached.data.data(), cached.data.size());
+        cached.lba = lba;
+    }
 
-    return std::make_pair(sector, TrackType::DATA);
+    return {cached.data.data(), Track::SECTOR_SIZE, TrackType::DATA};
 }
-}  // namespace disc::format
\ No newline at end of file
+}  // namespace disc::format
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <cstdio>
 #include <memory>
 #include <optional>
@@ -7,16 +8,44 @@
 #include "disc/disc.h"
 #include "disc/position.h"
 #include "disc/track.h"
+#include "ecm_sector.h"
 #include "utils/file.h"
+#include "utils/mapped_file.h"
 
 namespace disc::format {
+// Sectors are reconstructed from .ecm file on demand, using index of records built by EcmParser
 struct Ecm : public Disc {
+    struct Run {
+        uint64_t offset;      // Start in decoded image
+        uint64_t fileOffset;  // Start of stored data in .ecm file
+        uint32_t count;       // Number of sectors (bytes for Raw type)
+        ecm::Type type;
+    };
+
    private:
     std::string file;
-    std::vector<uint8_t> data;
+    std::vector<Run> runs;
+    uint64_t size;  // Decoded image size
+
+    std::unique_ptr<MappedFile> mapped;
+    unique_ptr_file f;  // Used only if file cannot be mapped
+
+    struct CachedSector {
+        size_t lba = SIZE_MAX;
+        std::array<uint8_t, Track::SECTOR_SIZE> data;
+    };
+    static const size_t CACHE_SIZE = 16;
+    std::array<CachedSector, CACHE_SIZE> cache;  // Direct mapped, sector is stored at lba % CACHE_SIZE
+
+    // Returns pointer to size bytes of .ecm file at offset, buffer is used if file is not mapped
+    const uint8_t* fileData(uint64_t offset, size_t size, uint8_t* buffer);
 
    public:
-    Ecm(std::string file, std::vector<uint8_t> data);
+    Ecm(std::string file, std::vector<Run> runs, uint64_t size);
+
+    // Decodes size bytes of image starting at offset, bytes outside of the image are zeroed
+    void decode(uint64_t offset, uint8_t* dst, size_t size);
+    uint64_t getImageSize() const { return size; }
 
     std::string getFile() const override;
     Position getDiskSize() const override;
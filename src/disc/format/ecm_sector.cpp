@@ -0,0 +1,181 @@
+#include "ecm_sector.h"
+#include <array>
+#include <cstring>
+
+namespace {
+// Slice-by-8 tables, edcLUT[0] is the usual bytewise table.
+// edcLUT[k][i] is CRC of byte i followed by k zero bytes.
+constexpr std::array<std::array<uint32_t, 256>, 8> edcLUT = []() {
+    std::array<std::array<uint32_t, 256>, 8> lut = {};
+    for (int i = 0; i < 256; i++) {
+        uint32_t edc = i;
+
+        for (int j = 0; j < 8; j++) {
+            bool carry = edc & 1;
+            edc = (edc >> 1) ^ (carry ? 0xD8018001 : 0);
+        }
+
+        lut[0][i] = edc;
+    }
+    for (int k = 1; k < 8; k++) {
+        for (int i = 0; i < 256; i++) {
+            lut[k][i] = (lut[k - 1][i] >> 8) ^ lut[0][lut[k - 1][i] & 0xff];
+        }
+    }
+    return lut;
+}();
+
+inline uint32_t load32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+constexpr uint32_t eccEntry(uint8_t i) { return (i << 1) ^ (i & 0x80 ? 0x11d : 0); }
+
+constexpr std::array<uint8_t, 256> eccbLUT = []() {
+    std::array<uint8_t, 256> lut = {};
+    for (int i = 0; i < 256; i++) {
+        lut[i ^ eccEntry(i)] = i;
+    }
+    return lut;
+}();
+
+// Multiplies 8 GF(2^8) elements packed in a word by 2, same as eccEntry for each byte
+inline uint64_t gfMul2(uint64_t x) {
+    uint64_t high = (x >> 7) & 0x0101'0101'0101'0101ull;
+    return ((x & 0x7f7f'7f7f'7f7f'7f7full) << 1) ^ (high * 0x1d);
+}
+
+// Reed-Solomon parity of all majorCount columns computed at once, 8 columns per word.
+// Row minor of the block holds byte of each column for that step (gathered by caller).
+template <int majorCount, int minorCount, typename Gather>
+void computeECCblock(Gather gatherRow, uint8_t* dst) {
+    const int WORDS = (majorCount + 7) / 8;
+    uint64_t a[WORDS] = {}, b[WORDS] = {};
+    uint8_t bytes[WORDS * 8] = {};  // Padding columns stay zero
+
+    for (int minor = 0; minor < minorCount; minor++) {
+        gatherRow(minor, bytes);
+
+        for (int i = 0; i < WORDS; i++) {
+            uint64_t row;
+            memcpy(&row, bytes + i * 8, 8);
+            a[i] = gfMul2(a[i] ^ row);
+            b[i] ^= row;
+        }
+    }
+
+    uint8_t aBytes[WORDS * 8], bBytes[WORDS * 8];
+    for (int i = 0; i < WORDS; i++) {
+        uint64_t v = gfMul2(a[i]) ^ b[i];
+        memcpy(aBytes + i * 8, &v, 8);
+        memcpy(bBytes + i * 8, &b[i], 8);
+    }
+    for (int major = 0; major < majorCount; major++) {
+        uint8_t parity = eccbLUT[aBytes[major]];
+        dst[major] = parity;
+        dst[major + majorCount] = parity ^ bBytes[major];
+    }
+}
+
+// Q parity reads diagonals of the frame, byte index for each step and column
+constexpr std::array<std::array<uint16_t, 52>, 43> qIndex = []() {
+    std::array<std::array<uint16_t, 52>, 43> lut = {};
+    for (int major = 0; major < 52; major++) {
+        int index = (major >> 1) * 86 + (major & 1);
+        for (int minor = 0; minor < 43; minor++) {
+            lut[minor][major] = index;
+            index += 88;
+            if (index >= 52 * 43) index -= 52 * 43;
+        }
+    }
+    return lut;
+}();
+
+void adjustEDC(uint8_t* frame, size_t addr, size_t size) {
+    uint32_t edc = disc::format::ecm::calculateEDC(frame + addr, size);
+    size_t offset = addr + size;
+
+    for (int i = 0; i < 4; i++) {
+        frame[offset + i] = (edc >> (i * 8)) & 0xff;
+    }
+}
+
+void adjustSync(uint8_t* frame) {
+    frame[0] = 0;
+    for (int i = 1; i < 11; i++) frame[i] = 0xff;
+    frame[11] = 0;
+}
+
+void copySubheader(uint8_t* frame) {
+    for (int i = 0x10; i < 0x14; i++) {
+        frame[i] = frame[i + 4];
+    }
+}
+}  // namespace
+
+namespace disc::format::ecm {
+uint32_t calculateEDC(const uint8_t* data, size_t size) {
+    uint32_t edc = 0;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint32_t lo = load32(data) ^ edc;
+        uint32_t hi = load32(data + 4);
+        edc = edcLUT[7][lo & 0xff] ^ edcLUT[6][(lo >> 8) & 0xff] ^ edcLUT[5][(lo >> 16) & 0xff] ^ edcLUT[4][lo >> 24]
+              ^ edcLUT[3][hi & 0xff] ^ edcLUT[2][(hi >> 8) & 0xff] ^ edcLUT[1][(hi >> 16) & 0xff] ^ edcLUT[0][hi >> 24];
+    }
+    for (; size > 0; size--) {
+        edc ^= *data++;
+        edc = (edc >> 8) ^ edcLUT[0][edc & 0xff];
+    }
+    return edc;
+}
+
+void calculateECC(uint8_t* frame) {
+    const uint8_t* src = frame + 0x0c;
+
+    // P parity, 86 columns of 24 bytes, each step reads a contiguous row
+    computeECCblock<86, 24>([src](int minor, uint8_t* row) { memcpy(row, src + minor * 86, 86); }, frame + 0x81c);
+
+    // Q parity, 52 diagonals of 43 bytes, covers P parity as well
+    computeECCblock<52, 43>(
+        [src](int minor, uint8_t* row) {
+            for (int major = 0; major < 52; major++) row[major] = src[qIndex[minor][major]];
+        },
+        frame + 0x8c8);
+}
+
+void decodeSector(Type type, const uint8_t* input, uint8_t* output) {
+    uint8_t frame[2352];
+
+    if (type == Type::Mode1) {
+        memcpy(frame + 0x0c, input, 3);
+        memcpy(frame + 0x10, input + 3, 0x800);
+
+        adjustSync(frame);
+        frame[0xf] = 0x01;
+
+        adjustEDC(frame, 0x00, 0x810);
+        for (int i = 0x814; i < 0x81c; i++) frame[i] = 0;
+
+        calculateECC(frame);
+
+        memcpy(output, frame, 2352);
+    } else if (type == Type::Mode2Form1) {
+        memcpy(frame + 0x14, input, 0x804);
+        copySubheader(frame);
+
+        adjustEDC(frame, 0x10, 0x808);
+
+        // Address is not included in ECC of mode 2 sectors
+        memset(frame + 0x0c, 0, 4);
+        calculateECC(frame);
+
+        memcpy(output, frame + 0x10, 2336);
+    } else if (type == Type::Mode2Form2) {
+        memcpy(frame + 0x14, input, 0x918);
+        copySubheader(frame);
+
+        adjustEDC(frame, 0x10, 0x91c);
+        // Mode2Form2 has no ECC
+
+        memcpy(output, frame + 0x10, 2336);
+    }
+}
+}  // namespace disc::format::ecm
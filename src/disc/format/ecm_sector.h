@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace disc::format::ecm {
+// Record types as stored in .ecm file
+enum class Type : uint8_t { Raw = 0, Mode1 = 1, Mode2Form1 = 2, Mode2Form2 = 3 };
+
+// Bytes stored in .ecm file per sector (per byte for Raw)
+constexpr size_t inputSize(Type type) {
+    switch (type) {
+        case Type::Mode1: return 0x803;
+        case Type::Mode2Form1: return 0x804;
+        case Type::Mode2Form2: return 0x918;
+        default: return 1;
+    }
+}
+
+// Bytes of decoded image per sector, mode 2 sectors are stored without sync and header
+constexpr size_t outputSize(Type type) {
+    switch (type) {
+        case Type::Mode1: return 2352;
+        case Type::Mode2Form1:
+        case Type::Mode2Form2: return 2336;
+        default: return 1;
+    }
+}
+
+// Rebuilds sync, header, EDC and ECC of a single sector, writes outputSize(type) bytes.
+// Raw type is not handled.
+void decodeSector(Type type, const uint8_t* input, uint8_t* output);
+
+uint32_t calculateEDC(const uint8_t* data, size_t size);
+
+// Computes P and Q parity of 2352 byte frame in place (header at 0x0c)
+void calculateECC(uint8_t* frame);
+}  // namespace disc::format::ecm
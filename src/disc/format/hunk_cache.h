@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace disc::format {
+// LRU cache of decompressed .chd hunks, not synchronized (Chd guards it with its mutex).
+// Pending hunks (allocated, still being decompressed) are never evicted.
+// Allocation counts as use, so a prefetched hunk outlives older ones until it is read.
+class HunkCache {
+   public:
+    struct Hunk {
+        size_t id = SIZE_MAX;
+        bool ready = false;  // Pending hunks are being decompressed by a worker
+        uint64_t lastUsed = 0;
+        std::vector<uint8_t> data;
+    };
+
+    void resize(size_t count, size_t hunkSize) {
+        hunks.resize(count);
+        for (auto& hunk : hunks) {
+            hunk.data.resize(hunkSize);
+        }
+    }
+
+    Hunk* find(size_t id) {
+        for (auto& hunk : hunks) {
+            if (hunk.id == id) return &hunk;
+        }
+        return nullptr;
+    }
+
+    // Evicts least recently used hunk that is not pending, returned hunk is pending
+    Hunk* allocate(size_t id) {
+        Hunk* lru = nullptr;
+        for (auto& hunk : hunks) {
+            if (hunk.id != SIZE_MAX && !hunk.ready) continue;
+            if (lru == nullptr || hunk.lastUsed < lru->lastUsed) lru = &hunk;
+        }
+
+        lru->id = id;
+        lru->ready = false;
+        lru->lastUsed = ++useCounter;
+        return lru;
+    }
+
+    void touch(Hunk* hunk) { hunk->lastUsed = ++useCounter; }
+
+    size_t size() const { return hunks.size(); }
+
+   private:
+    std::vector<Hunk> hunks;
+    uint64_t useCounter = 0;
+};
+}  // namespace disc::format
@@ -1,12 +1,15 @@
 #include "load.h"
 #include <array>
 #include <disc/format/ecm_parser.h>
+#include "disc/format/cbin.h"
 #include "disc/format/chd_format.h"
+#include "config.h"
 #include "disc/format/cue_parser.h"
+#include "disc/read_ahead.h"
 #include "utils/file.h"
 
 namespace disc {
-const std::array<std::string, 6> discFormats = {"chd", "cue", "iso", "bin", "img", "ecm"};
+const std::array<std::string, 7> discFormats = {"chd", "cue", "iso", "bin", "img", "ecm", "cbin"};
 
 bool isDiscImage(const std::string& path) {
     std::string ext = getExtension(path);
@@ -21,7 +24,7 @@ std::unique_ptr<disc::Disc> load(const std::string& path) {
 
     std::unique_ptr<disc::Disc> disc;
     if (ext == "chd") {
-        disc = disc::format::Chd::open(path);
+        disc = disc::format::Chd::open(path, config.options.emulator.chdCacheSize, config.options.emulator.chdThreads);
     } else if (ext == "cue") {
         disc::format::CueParser parser;
         disc = parser.parse(path.c_str());
@@ -30,6 +33,12 @@ std::unique_ptr<disc::Disc> load(const std::string& path) {
     } else if (ext == "ecm") {
         disc::format::EcmParser parser;
         disc = parser.parse(path.c_str());
+    } else if (ext == "cbin") {
+        disc = disc::format::Cbin::open(path);
+    }
+
+    if (disc && config.options.emulator.readAhead) {
+        disc = std::make_unique<ReadAhead>(std::move(disc));
     }
 
     return disc;
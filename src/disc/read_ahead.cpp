@@ -0,0 +1,114 @@
+#include "read_ahead.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace disc {
+ReadAhead::ReadAhead(std::unique_ptr<Disc> disc) : disc(std::move(disc)), diskEnd(this->disc->getDiskSize().toLba()) {
+    workerThread = std::thread(&ReadAhead::workerThreadFunc, this);
+}
+
+ReadAhead::~ReadAhead() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        workerThreadExit = true;
+    }
+    workerCv.notify_one();
+    workerThread.join();
+}
+
+void ReadAhead::schedule(int lba) {
+    int end = std::max(lba + 1, std::min(lba + WINDOW * speed, diskEnd));
+    if (fillPos < lba || fillPos > end) {
+        fillPos = lba;
+    }
+    fillEnd = end;
+    workerCv.notify_one();
+}
+
+Sector ReadAhead::read(Position pos) {
+    int lba = pos.toLba();
+
+    if (lba == lastLba) {
+        return lastSector;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    Slot& slot = slots[slotIndex(lba)];
+
+    if (slot.lba == lba) {
+        stats.hits++;
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        fillPos = lba;
+        schedule(lba);
+        readyCv.wait(lock, [&] { return slot.lba == lba; });
+
+        auto waited = std::chrono::steady_clock::now() - start;
+        stats.stalls++;
+        stats.stallMicros += std::chrono::duration_cast<std::chrono::microseconds>(waited).count();
+    }
+
+    std::copy_n(slot.data.begin(), slot.size, buffer.begin());
+    lastSector = Sector(buffer.data(), slot.size, slot.type);
+    lastQ = slot.q;
+    lastLba = lba;
+
+    // Keep the window moving with the drive
+    schedule(lba + 1);
+
+    return lastSector;
+}
+
+SubchannelQ ReadAhead::getSubQ(Position pos) {
+    // Q is read together with the sector by the worker
+    if (pos.toLba() != lastLba) {
+        read(pos);
+    }
+    return lastQ;
+}
+
+void ReadAhead::prefetch(Position pos, int speed) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->speed = std::max(speed, 1);
+    schedule(pos.toLba());
+}
+
+ReadAhead::Stats ReadAhead::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void ReadAhead::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = Stats();
+}
+
+void ReadAhead::workerThreadFunc() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workerCv.wait(lock, [this] { return workerThreadExit || fillPos < fillEnd; });
+        if (workerThreadExit) {
+            break;
+        }
+
+        int lba = fillPos++;
+        Slot& slot = slots[slotIndex(lba)];
+        if (slot.lba == lba) {
+            continue;
+        }
+        slot.lba = -1;
+
+        lock.unlock();
+        Sector sector = disc->read(Position::fromLba(lba));
+        slot.size = std::min(sector.size, slot.data.size());
+        slot.type = sector.type;
+        if (slot.size) memcpy(slot.data.data(), sector.data, slot.size);
+        slot.q = disc->getSubQ(Position::fromLba(lba));  // Can invalidate sector view, called after the copy
+        lock.lock();
+
+        slot.lba = lba;
+        readyCv.notify_all();
+    }
+}
+}  // namespace disc
@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "disc.h"
+
+namespace disc {
+// Wraps another Disc and reads sectors ahead of the emulated drive on a background thread,
+// so file I/O and decompression (CHD, ECM) are off the emulation thread.
+// Only the worker thread calls read() on the wrapped disc, track queries are forwarded directly.
+struct ReadAhead : public Disc {
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t stalls = 0;       // Sector wasn't cached, read() had to wait for the worker
+        uint64_t stallMicros = 0;  // Total time spent waiting
+    };
+
+    explicit ReadAhead(std::unique_ptr<Disc> disc);
+    ~ReadAhead() override;
+
+    Sector read(Position pos) override;
+    SubchannelQ getSubQ(Position pos) override;
+    void prefetch(Position pos, int speed) override;
+
+    std::string getFile() const override { return disc->getFile(); }
+    size_t getTrackCount() const override { return disc->getTrackCount(); }
+    int getTrackByPosition(Position pos) const override { return disc->getTrackByPosition(pos); }
+    Position getTrackStart(int track) const override { return disc->getTrackStart(track); }
+    Position getTrackLength(int track) const override { return disc->getTrackLength(track); }
+    Position getDiskSize() const override { return disc->getDiskSize(); }
+
+    Disc* getDisc() const { return disc.get(); }
+    Stats getStats() const;
+    void resetStats();
+
+   private:
+    static const int SLOTS = 256;  // ~600kB, over 1.5s of data at 2x speed
+    static const int WINDOW = 32;  // Sectors read ahead of the drive at 1x speed
+
+    struct Slot {
+        int lba = -1;
+        TrackType type = TrackType::INVALID;
+        size_t size = 0;
+        std::array<uint8_t, 2352> data;
+        SubchannelQ q;
+    };
+
+    std::unique_ptr<Disc> disc;
+    const int diskEnd;
+
+    // Direct mapped, sector is cached in slots[lba % SLOTS].
+    // Worker invalidates slot (lba = -1) under lock and fills it without holding the lock.
+    std::array<Slot, SLOTS> slots;
+
+    // Copy of last returned sector, owned by emulation thread
+    std::array<uint8_t, 2352> buffer;
+    Sector lastSector;
+    SubchannelQ lastQ;
+    int lastLba = -1;
+
+    mutable std::mutex mutex;
+    std::condition_variable workerCv;  // New work scheduled or exit requested
+    std::condition_variable readyCv;   // Slot was filled
+    int fillPos = 0;                   // Next sector to be read by worker
+    int fillEnd = 0;                   // Worker stops before this sector
+    int speed = 1;
+    Stats stats;
+
+    std::thread workerThread;
+    bool workerThreadExit = false;
+    void workerThreadFunc();
+
+    static int slotIndex(int lba) { return lba % SLOTS; }
+
+    // Must be called with mutex held
+    void schedule(int lba);
+};
+}  // namespace disc
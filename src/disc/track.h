@@ -27,4 +27,6 @@ struct Track {
         frames = 0;
     }
 };
+
+static_assert(ZERO_SECTOR.size() == Track::SECTOR_SIZE);
 }  // namespace disc
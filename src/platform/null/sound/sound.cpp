@@ -1,10 +1,5 @@
 #include "sound/sound.h"
 
-namespace Sound {
-std::deque<uint16_t> buffer;
-std::mutex audioMutex;
-}  // namespace Sound
-
 void Sound::init() {}
 
 void Sound::play() {}
@@ -12,3 +7,5 @@ void Sound::play() {}
 void Sound::stop() {}
 
 void Sound::close() {}
+
+uint64_t Sound::underruns() { return 0; }
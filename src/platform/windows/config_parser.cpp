@@ -50,11 +50,16 @@ void saveConfigFile() {
 
     json["options"]["sound"] = {
         {"enabled", config.options.sound.enabled},
+        {"blockSize", config.options.sound.blockSize},
     };
 
     json["options"]["emulator"] = {
         {"preserveState", config.options.emulator.preserveState},
         {"timeTravel", config.options.emulator.timeTravel},
+        {"readAhead", config.options.emulator.readAhead},
+        {"chdCacheSize", config.options.emulator.chdCacheSize},
+        {"chdThreads", config.options.emulator.chdThreads},
+        {"instantDisc", config.options.emulator.instantDisc},
     };
 
     auto l = config.debug.log;
@@ -120,11 +125,16 @@ void loadConfigFile() {
 
         if (auto s = json["options"]["sound"]; !s.is_null()) {
             config.options.sound.enabled = s["enabled"];
+            config.options.sound.blockSize = s.value("blockSize", config.options.sound.blockSize);
         }
 
         if (auto e = json["options"]["emulator"]; !e.is_null()) {
             config.options.emulator.preserveState = e["preserveState"];
             config.options.emulator.timeTravel = e["timeTravel"];
+            config.options.emulator.readAhead = e.value("readAhead", config.options.emulator.readAhead);
+            config.options.emulator.chdCacheSize = e.value("chdCacheSize", config.options.emulator.chdCacheSize);
+            config.options.emulator.chdThreads = e.value("chdThreads", config.options.emulator.chdThreads);
+            config.options.emulator.instantDisc = e.value("instantDisc", config.options.emulator.instantDisc);
         }
 
         if (auto l = json["debug"]["log"]; !l.is_null()) {
@@ -1,8 +1,10 @@
 #include "cdrom.h"
 #include <fmt/core.h>
 #include <imgui.h>
+#include "config.h"
 #include "disc/empty.h"
 #include "disc/format/cue.h"
+#include "disc/read_ahead.h"
 #include "system.h"
 
 using namespace disc;
@@ -14,6 +16,10 @@ void Cdrom::cdromWindow(System* sys) {
     ImGui::Begin("CDROM", &cdromWindowOpen);
 
     Disc* disc = sys->cdrom->disc.get();
+    auto readAhead = dynamic_cast<ReadAhead*>(disc);
+    if (readAhead) {
+        disc = readAhead->getDisc();
+    }
 
     if (auto noCd = dynamic_cast<Empty*>(disc)) {
         ImGui::Text("No CD");
@@ -45,6 +51,32 @@ void Cdrom::cdromWindow(System* sys) {
 
         ImGui::Checkbox("Use frames", &useFrames);
     }
+
+    if (readAhead) {
+        auto stats = readAhead->getStats();
+        uint64_t reads = stats.hits + stats.stalls;
+        ImGui::Separator();
+        ImGui::Text("Read ahead: %.1f%% hits, %llu stalls (%.1f ms)", reads ? 100.0 * stats.hits / reads : 0.0,
+                    (unsigned long long)stats.stalls, stats.stallMicros / 1000.0);
+        ImGui::SameLine();
+        if (ImGui::Button("Reset##readAhead")) {
+            readAhead->resetStats();
+        }
+    }
+
+    if (config.options.emulator.instantDisc) {
+        ImGui::Separator();
+        ImGui::Text("Instant disc: %.1f s of loading skipped", sys->cdrom->getSavedSeconds());
+    }
+
+    auto& audio = sys->cdrom->audio;
+    ImGui::Separator();
+    ImGui::Text("Audio buffer: %zu / %zu samples (peak %zu)", audio.size(), audio.capacity(), audio.getPeak());
+    ImGui::Text("Underruns: %zu, dropped samples: %zu", audio.getUnderruns(), audio.getOverruns());
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        audio.resetStats();
+    }
     ImGui::End();
 }
 
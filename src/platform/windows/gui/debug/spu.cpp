@@ -304,29 +304,31 @@ void renderSamples(spu::SPU* spu) {
 }
 
 void SPU::recordingWindow(spu::SPU* spu) {
-    if (ImGui::Button(spu->recording ? "Pause" : "Record")) {
-        spu->recording = !spu->recording;
-    }
-    if (!spu->recordBuffer.empty()) {
-        if (!spu->recording) {
-            ImGui::SameLine();
-            if (ImGui::Button("Save")) {
-                auto t = std::time(nullptr);
-                std::stringstream ss;
-                ss << std::put_time(std::localtime(&t), "spu-%Y-%m-%d_%H-%M-%S.wav");
-                auto file = ss.str();
-
-                bool saved = wave::writeToFile(spu->recordBuffer, fmt::format("{}/{}", avocado::PATH_USER, file).c_str());
-                toast(saved ? fmt::format("Saved to {}", file) : fmt::format("Problem saving to {}", file));
-                if (saved) {
-                    spu->recordBuffer.clear();
-                    showOpenDirectory = true;
-                }
+    auto& recorder = spu->recorder;
+    if (!recorder.isRecording()) {
+        if (ImGui::Button("Record")) {
+            auto t = std::time(nullptr);
+            std::stringstream ss;
+            ss << std::put_time(std::localtime(&t), "spu-%Y-%m-%d_%H-%M-%S.wav");
+            recordingFile = ss.str();
+
+            if (!recorder.start(fmt::format("{}/{}", avocado::PATH_USER, recordingFile))) {
+                toast(fmt::format("Problem saving to {}", recordingFile));
             }
         }
+    } else {
+        if (ImGui::Button("Stop")) {
+            recorder.stop();
+            toast(recorder.failed() ? fmt::format("Problem saving to {}", recordingFile) : fmt::format("Saved to {}", recordingFile));
+            showOpenDirectory = true;
+        }
 
         ImGui::SameLine();
-        ImGui::TextUnformatted(fmt::format("{:.2f} seconds captured...", spu->recordBuffer.size() / 44100.f / 2).c_str());
+        ImGui::TextUnformatted(fmt::format("{:.2f} seconds captured...", recorder.seconds()).c_str());
+        if (recorder.dropped() > 0) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(fmt::format("({} samples dropped)", recorder.dropped()).c_str());
+        }
     }
 
     if (showOpenDirectory) {
@@ -1,4 +1,5 @@
 #pragma once
+#include <string>
 
 struct System;
 
@@ -9,6 +10,7 @@ struct SPU;
 namespace gui::debug {
 class SPU {
     bool showOpenDirectory = false;
+    std::string recordingFile;
 
     void spuWindow(spu::SPU* spu);
 
@@ -5,13 +5,14 @@ namespace gui::file {
 Open::Open() : FileDialog(Mode::OpenFile) { windowName = "Open file##file_dialog"; }
 
 bool Open::isFileSupported(const gui::helper::File& f) {
-    constexpr std::array<const char*, 12> supportedFiles = {
+    constexpr std::array<const char*, 13> supportedFiles = {
         ".iso",          //
         ".cue",          //
         ".bin",          //
         ".img",          //
         ".chd",          //
         ".ecm",          //
+        ".cbin",         //
         ".exe",          //
         ".psexe",        //
         ".psf",          //
@@ -10,6 +10,7 @@
 #include "imgui/imgui_impl_sdl.h"
 #include "platform/windows/input/key.h"
 #include "platform/windows/gui/icons.h"
+#include "sound/sound.h"
 #include "system.h"
 #include "state/state.h"
 #include "utils/file.h"
@@ -240,6 +241,11 @@ void GUI::mainMenu(std::unique_ptr<System>& sys) {
             config.options.emulator.timeTravel = timeTravel;
         }
 
+        bool instantDisc = config.options.emulator.instantDisc;
+        if (ImGui::MenuItem("Instant disc loading", nullptr, &instantDisc)) {
+            config.options.emulator.instantDisc = instantDisc;
+        }
+
         ImGui::EndMenu();
     }
     if (ImGui::BeginMenu("Free Camera")) {
@@ -395,7 +401,10 @@ void GUI::mainMenu(std::unique_ptr<System>& sys) {
 
     if (ImGui::IsItemHovered()) {
         ImGui::BeginTooltip();
-        ImGui::TextUnformatted(fmt::format("Frame time: {:.2f} ms\nTab to disable frame limiting", (1000.0 / statusFps)).c_str());
+        ImGui::TextUnformatted(fmt::format("Frame time: {:.2f} ms\nGL calls: {} ({} draw calls)\nAudio underruns: {}, overruns: {} "
+                                           "frames\nTab to disable frame limiting",
+                                           (1000.0 / statusFps), statusGlCalls, statusDrawCalls, Sound::underruns(), Sound::overruns())
+                                   .c_str());
         ImGui::EndTooltip();
     }
     ImGui::EndMainMenuBar();
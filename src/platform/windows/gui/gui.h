@@ -58,6 +58,8 @@ class GUI {
 
     // Status
     double statusFps = 0.0;
+    uint32_t statusGlCalls = 0;
+    uint32_t statusDrawCalls = 0;
     bool statusFramelimitter = true;
     bool statusMouseLocked = false;
 
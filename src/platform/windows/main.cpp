@@ -435,6 +435,8 @@ int main(int argc, char** argv) {
             screenshot->updateTextures(sys->gpu.get());
         }
 
+        gui->statusGlCalls = opengl->lastFrameStatistics.calls;
+        gui->statusDrawCalls = opengl->lastFrameStatistics.drawCalls;
         gui->statusFramelimitter = frameLimitEnabled;
         gui->statusMouseLocked = inputManager->mouseLocked;
         gui->render(sys);
@@ -1,29 +1,21 @@
 #include "sound/sound.h"
 #include <SDL.h>
 #include <fmt/core.h>
-
-namespace Sound {
-std::deque<uint16_t> buffer;
-std::mutex audioMutex;
-};  // namespace Sound
+#include <atomic>
+#include <cstring>
 
 namespace {
 SDL_AudioDeviceID dev = 0;
+std::atomic<uint64_t> underrunFrames{0};
 
 void audioCallback(void* userdata, Uint8* raw_stream, int len) {
     (void)userdata;
 
-    for (int i = 0; i < len; i++) raw_stream[i] = 0;
-
-    std::unique_lock<std::mutex> lock(Sound::audioMutex);
-    size_t bufSize = Sound::buffer.size();
-    for (size_t i = 0; i < (size_t)len; i += 2) {
-        if (i / 2 >= bufSize) break;
-
-        int16_t sample = Sound::buffer.front();
-        Sound::buffer.pop_front();
-        raw_stream[i] = sample & 0xff;
-        raw_stream[i + 1] = (sample >> 8) & 0xff;
+    size_t frames = len / sizeof(Sound::Frame);
+    size_t read = Sound::buffer.pop(raw_stream, frames);
+    if (read < frames) {
+        memset(raw_stream + read * sizeof(Sound::Frame), 0, (frames - read) * sizeof(Sound::Frame));
+        underrunFrames.fetch_add(frames - read, std::memory_order_relaxed);
     }
 }
 }  // namespace
@@ -31,8 +23,8 @@ void audioCallback(void* userdata, Uint8* raw_stream, int len) {
 void Sound::init() {
     SDL_AudioSpec desired = {}, obtained;
     desired.freq = 44100;
-    desired.format = AUDIO_S16;
-    desired.channels = 2;
+    desired.format = AUDIO_S16SYS;
+    desired.channels = CHANNELS;
     desired.samples = 512;
     desired.callback = audioCallback;
 
@@ -56,4 +48,4 @@ void Sound::stop() { SDL_PauseAudioDevice(dev, true); }
 
 void Sound::close() { SDL_CloseAudioDevice(dev); }
 
-void Sound::clearBuffer() { buffer.clear(); }
+uint64_t Sound::underruns() { return underrunFrames.load(std::memory_order_relaxed); }
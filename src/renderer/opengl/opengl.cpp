@@ -51,6 +51,20 @@ bool OpenGL::loadShaders() {
         fmt::print("[GL] Cannot load copy shader: {}\n", copyShader->getError());
         return false;
     }
+
+    // Resolve everything that doesn't change between frames once
+    renderShader->use();
+    renderShader->getUniform("vram").i(0);
+    renderShader->bindUniformBlock("FrameConstants", frameConstantsBinding);
+
+    blitShader->use();
+    blitShader->getUniform("renderBuffer").i(0);
+    blitResolution = blitShader->getUniform("iResolution");
+    blitDisplayHorizontal = blitShader->getUniform("displayHorizontal");
+    blitDisplayVertical = blitShader->getUniform("displayVertical");
+    blitDisplayEnabled = blitShader->getUniform("displayEnabled");
+
+    glUseProgram(0);
     return true;
 }
 
@@ -98,6 +112,7 @@ bool OpenGL::setup() {
     renderFramebuffer = std::make_unique<Framebuffer>(renderTex->get());
 
     blitBuffer = std::make_unique<Buffer>(makeBlitBuf().size() * sizeof(BlitStruct));
+    frameConstantsBuffer = std::make_unique<UniformBuffer>(sizeof(FrameConstants), frameConstantsBinding);
 
     vramTex.release();
 
@@ -184,6 +199,19 @@ void OpenGL::bindCopyAttributes() {
     copyShader->getAttrib("texcoord").pointer(2, GL_FLOAT, sizeof(BlitStruct), 2 * sizeof(float));
 }
 
+void OpenGL::updateFrameConstants(gpu::GPU* gpu) {
+    FrameConstants constants = {};
+    constants.displayAreaPos[0] = lastDisplayAreaPos.x;
+    constants.displayAreaPos[1] = lastDisplayAreaPos.y;
+    constants.displayAreaSize[0] = static_cast<float>(gpu->gp1_08.getHorizontalResoulution());
+    constants.displayAreaSize[1] = static_cast<float>(gpu->gp1_08.getVerticalResoulution());
+    constants.vramSize[0] = static_cast<float>(gpu::VRAM_WIDTH);
+    constants.vramSize[1] = static_cast<float>(gpu::VRAM_HEIGHT);
+    constants.is24bit = gpu->gp1_08.colorDepth == gpu::GP1_08::ColorDepth::bit24;
+
+    frameConstantsBuffer->update(sizeof(FrameConstants), &constants);
+}
+
 void OpenGL::update24bitTexture(gpu::GPU* gpu) {
     size_t dataSize = gpu::VRAM_HEIGHT * gpu::VRAM_WIDTH * 3;
     if (vram24Unpacked.size() != dataSize) {
@@ -243,19 +271,13 @@ void OpenGL::updateVramTexture(gpu::GPU* gpu) {
 }
 
 void OpenGL::renderVertices(gpu::GPU* gpu) {
-    static vec2 lastPos;
     auto& buffer = gpu->vertices;
     if (buffer.empty()) {
         return;
     }
 
-    int areaX = static_cast<int>(lastPos.x);
-    int areaY = static_cast<int>(lastPos.y);
-    int areaW = static_cast<int>(gpu->gp1_08.getHorizontalResoulution());
-    int areaH = static_cast<int>(gpu->gp1_08.getVerticalResoulution());
-
     // Simulate GPU in Shader (skip if no entries in renderlist)
-    glViewport(0, 0, renderWidth, renderHeight);
+    GLCALL(glViewport(0, 0, renderWidth, renderHeight));
     renderFramebuffer->bind();
 
     renderShader->use();
@@ -263,13 +285,10 @@ void OpenGL::renderVertices(gpu::GPU* gpu) {
     renderBuffer->update(sizeof(gpu::Vertex) * buffer.size(), buffer.data());
     bindRenderAttributes();
 
-    // Set uniforms
+    // Uniforms are in FrameConstants buffer
     vramTex->bind(0);
-    renderShader->getUniform("vram").i(0);
-    renderShader->getUniform("displayAreaPos").f(areaX, areaY);
-    renderShader->getUniform("displayAreaSize").f(areaW, areaH);
 
-    glBlendColor(0.25f, 0.25f, 0.25f, 0.5f);
+    GLCALL(glBlendColor(0.25f, 0.25f, 0.25f, 0.5f));
 
     // Unbatched render
     using Transparency = gpu::SemiTransparency;
@@ -297,29 +316,30 @@ void OpenGL::renderVertices(gpu::GPU* gpu) {
         if (buffer[i].flags & gpu::Vertex::SemiTransparency) {
             auto semi = static_cast<Transparency>((buffer[i].flags >> 5) & 3);
 
-            glBlendEquationSeparate(semi == Transparency::BminusF ? GL_FUNC_REVERSE_SUBTRACT : GL_FUNC_ADD, GL_FUNC_ADD);
+            GLCALL(glBlendEquationSeparate(semi == Transparency::BminusF ? GL_FUNC_REVERSE_SUBTRACT : GL_FUNC_ADD, GL_FUNC_ADD));
             switch (semi) {
                 case Transparency::Bby2plusFby2:
-                    isTextured ? glBlendFunc(GL_ONE, GL_SRC_ALPHA) : glBlendFunc(GL_CONSTANT_ALPHA, GL_CONSTANT_ALPHA); break;
+                    GLCALL(isTextured ? glBlendFunc(GL_ONE, GL_SRC_ALPHA) : glBlendFunc(GL_CONSTANT_ALPHA, GL_CONSTANT_ALPHA)); break;
                 case Transparency::BplusF:
                 case Transparency::BminusF:
-                    isTextured ? glBlendFunc(GL_ONE, GL_SRC_ALPHA) : glBlendFunc(GL_ONE, GL_ONE); break;
+                    GLCALL(isTextured ? glBlendFunc(GL_ONE, GL_SRC_ALPHA) : glBlendFunc(GL_ONE, GL_ONE)); break;
                 case Transparency::BplusFby4:
-                    isTextured ? glBlendFunc(GL_CONSTANT_COLOR, GL_SRC_ALPHA) : glBlendFunc(GL_CONSTANT_COLOR, GL_ONE); break;
+                    GLCALL(isTextured ? glBlendFunc(GL_CONSTANT_COLOR, GL_SRC_ALPHA) : glBlendFunc(GL_CONSTANT_COLOR, GL_ONE)); break;
             }
 
-            glEnable(GL_BLEND);
+            GLCALL(glEnable(GL_BLEND));
         } else {
-            glDisable(GL_BLEND);
+            GLCALL(glDisable(GL_BLEND));
         }
 
-        glDrawArrays(GL_TRIANGLES, i, count);
+        GLCALL(glDrawArrays(GL_TRIANGLES, i, count));
+        glStatistics.drawCalls++;
     }
-    lastPos = vec2(gpu->displayAreaStartX, gpu->displayAreaStartY);
+    lastDisplayAreaPos = vec2(gpu->displayAreaStartX, gpu->displayAreaStartY);
 
-    glBlendColor(1.f, 1.f, 1.f, 1.f);
-    glDisable(GL_BLEND);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLCALL(glBlendColor(1.f, 1.f, 1.f, 1.f));
+    GLCALL(glDisable(GL_BLEND));
+    GLCALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
 }
 
 void OpenGL::renderBlit(gpu::GPU* gpu, bool software) {
@@ -373,14 +393,14 @@ void OpenGL::renderBlit(gpu::GPU* gpu, bool software) {
         // Move display to right by offset
         x += displayXOffset * w;
 
-        blitShader->getUniform("iResolution").f(w, h);
-        blitShader->getUniform("displayHorizontal").f(displayLeft + xOffset, displayRight + xOffset);
-        blitShader->getUniform("displayVertical").f(displayTop - yOffset, displayBottom - yOffset);
+        blitResolution.f(w, h);
+        blitDisplayHorizontal.f(displayLeft + xOffset, displayRight + xOffset);
+        blitDisplayVertical.f(displayTop - yOffset, displayBottom - yOffset);
     }
 
-    blitShader->getUniform("displayEnabled").i(!gpu->displayDisable);
+    blitDisplayEnabled.i(!gpu->displayDisable);
 
-    glViewport(x, y, w, h);
+    GLCALL(glViewport(x, y, w, h));
     blitBuffer->update(bb.size() * sizeof(BlitStruct), bb.data());
 
     blitBuffer->bind();
@@ -394,17 +414,19 @@ void OpenGL::renderBlit(gpu::GPU* gpu, bool software) {
     } else {
         renderTex->bind(0);
     }
-    blitShader->getUniform("renderBuffer").i(0);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    GLCALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GLCALL(glDrawArrays(GL_TRIANGLES, 0, 6));
+    glStatistics.drawCalls++;
 }
 
 void OpenGL::render(gpu::GPU* gpu) {
     vao->bind();
     // Clear framebuffer
-    glClearColor(0.f, 0.f, 0.f, 1.f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    GLCALL(glClearColor(0.f, 0.f, 0.f, 1.f));
+    GLCALL(glClear(GL_COLOR_BUFFER_BIT));
+
+    updateFrameConstants(gpu);
 
     if (gpu->gp1_08.colorDepth == gpu::GP1_08::ColorDepth::bit24) {
         // HACK: Force software rendering for movies (24bit mode)
@@ -432,4 +454,7 @@ void OpenGL::render(gpu::GPU* gpu) {
     Buffer::currentId = 0;
     Framebuffer::currentId = 0;
     // glViewport(0, 0, width, height);
+
+    lastFrameStatistics = glStatistics;
+    glStatistics = {};
 }
@@ -6,7 +6,9 @@
 #include "shader/framebuffer.h"
 #include "shader/program.h"
 #include "shader/texture.h"
+#include "shader/uniform_buffer.h"
 #include "shader/vertex_array_object.h"
+#include "statistics.h"
 
 class OpenGL {
    public:
@@ -28,6 +30,9 @@ class OpenGL {
     int height = resHeight;
     float aspect = RATIO_4_3;
 
+    // GL calls issued by the renderer during last render()
+    GLStatistics lastFrameStatistics;
+
     OpenGL();
     ~OpenGL();
     bool setup();
@@ -40,6 +45,16 @@ class OpenGL {
         float tex[2];
     };
 
+    // Layout must match FrameConstants block (std140) in shaders
+    struct FrameConstants {
+        float displayAreaPos[2];
+        float displayAreaSize[2];
+        float vramSize[2];
+        int32_t is24bit;
+        int32_t _pad;
+    };
+    static const GLuint frameConstantsBinding = 0;
+
     const int bufferSize = 10000;
 
     bool hardwareRendering;
@@ -51,20 +66,29 @@ class OpenGL {
     std::unique_ptr<Texture> renderTex;
     std::unique_ptr<Texture> vramTex;
     std::unique_ptr<Texture> vram24Tex;
+    std::unique_ptr<UniformBuffer> frameConstantsBuffer;
     bool supportNativeTexture;
 
+    // Display area used by vertices submitted in current frame
+    vec2 lastDisplayAreaPos;
+
     int renderWidth;
     int renderHeight;
 
     // VRAM to screen blit
     std::unique_ptr<Program> blitShader;
     std::unique_ptr<Buffer> blitBuffer;
+    Uniform blitResolution;
+    Uniform blitDisplayHorizontal;
+    Uniform blitDisplayVertical;
+    Uniform blitDisplayEnabled;
 
     std::unique_ptr<Program> copyShader;
 
     bool loadExtensions();
     bool loadShaders();
     void bindRenderAttributes();
+    void updateFrameConstants(gpu::GPU* gpu);
     void renderVertices(gpu::GPU* gpu);
 
     std::vector<uint8_t> vram24Unpacked;
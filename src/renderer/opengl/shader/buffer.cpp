@@ -1,4 +1,5 @@
 #include "buffer.h"
+#include "renderer/opengl/statistics.h"
 
 GLuint Buffer::currentId = 0;
 
@@ -17,13 +18,13 @@ Buffer::~Buffer() { glDeleteBuffers(1, &id); }
 
 void Buffer::update(int size, const void* data) {
     bind();
-    glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    GLCALL(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
 }
 
 void Buffer::bind() {
     if (currentId != id) {
         currentId = id;
-        glBindBuffer(GL_ARRAY_BUFFER, id);
+        GLCALL(glBindBuffer(GL_ARRAY_BUFFER, id));
     }
 }
 
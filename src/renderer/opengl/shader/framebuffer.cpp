@@ -1,4 +1,5 @@
 #include "framebuffer.h"
+#include "renderer/opengl/statistics.h"
 #include <fmt/core.h>
 
 GLuint Framebuffer::currentId = 0;
@@ -23,7 +24,7 @@ Framebuffer::~Framebuffer() { glDeleteFramebuffers(1, &id); }
 void Framebuffer::bind() {
     if (currentId != id) {
         currentId = id;
-        glBindFramebuffer(GL_FRAMEBUFFER, id);
+        GLCALL(glBindFramebuffer(GL_FRAMEBUFFER, id));
     }
 }
 
@@ -1,5 +1,6 @@
 #include "program.h"
 #include <fmt/core.h>
+#include "renderer/opengl/statistics.h"
 #include "utils/file.h"
 
 Program::Program(std::string name) { this->name = name; }
@@ -26,6 +27,8 @@ bool Program::load() {
     GLuint id = link(newShaders);
     if (id == 0) return false;
 
+    cacheUniforms(id);
+
     shaders = move(newShaders);
     programId = id;
     initialized = true;
@@ -61,6 +64,35 @@ GLuint Program::link(std::vector<Shader>& shaders) {
     return id;
 }
 
+// Resolve locations of all active uniforms once, getUniform is used in per frame code
+void Program::cacheUniforms(GLuint id) {
+    uniforms.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string buffer;
+    buffer.resize(maxLength);
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(id, i, maxLength, &length, &size, &type, &buffer[0]);
+
+        std::string uniformName = buffer.substr(0, length);
+        GLint loc = glGetUniformLocation(id, uniformName.c_str());
+        if (loc == -1) continue;  // Member of uniform block
+
+        // Arrays are reported as "name[0]"
+        if (auto bracket = uniformName.find('['); bracket != std::string::npos) {
+            uniformName = uniformName.substr(0, bracket);
+        }
+        uniforms.emplace(uniformName, Uniform(loc));
+    }
+}
+
 GLuint Program::get() { return programId; }
 
 std::string Program::getError() { return error; }
@@ -71,7 +103,7 @@ bool Program::use() {
         error = std::string("Program not linked.");
         return false;
     }
-    glUseProgram(programId);
+    GLCALL(glUseProgram(programId));
     return true;
 }
 
@@ -95,12 +127,21 @@ Uniform Program::getUniform(const char* name) {
     if (auto key = uniforms.find(name); key != uniforms.end()) {
         return key->second;
     }
-    GLint loc = glGetUniformLocation(programId, name);
-    if (loc == -1) {
-        fmt::print("[GL] Cannot find uniform \"{}\" in program {}\n", name, this->name);
-    }
-    auto uniform = Uniform(loc);
+    // Not active in linked program, remember it to print the warning only once
+    fmt::print("[GL] Cannot find uniform \"{}\" in program {}\n", name, this->name);
+    auto uniform = Uniform(-1);
     uniforms.emplace(name, uniform);
 
     return uniform;
+}
+
+bool Program::bindUniformBlock(const char* name, GLuint binding) {
+    if (!initialized) return false;
+    GLuint index = glGetUniformBlockIndex(programId, name);
+    if (index == GL_INVALID_INDEX) {
+        fmt::print("[GL] Cannot find uniform block \"{}\" in program {}\n", name, this->name);
+        return false;
+    }
+    glUniformBlockBinding(programId, index, binding);
+    return true;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <opengl.h>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include "attribute.h"
@@ -12,10 +13,11 @@ class Program {
     std::vector<Shader> shaders;
     GLuint programId = 0;
     std::unordered_map<const char*, Attribute> attributes;
-    std::unordered_map<const char*, Uniform> uniforms;
+    std::unordered_map<std::string, Uniform> uniforms;
 
     void destroy();
     GLuint link(std::vector<Shader>& shaders);
+    void cacheUniforms(GLuint id);
     bool initialized;
 
    public:
@@ -31,4 +33,5 @@ class Program {
     bool use();
     Attribute getAttrib(const char* name);
     Uniform getUniform(const char* name);
+    bool bindUniformBlock(const char* name, GLuint binding);
 };
@@ -1,4 +1,5 @@
 #include "texture.h"
+#include "renderer/opengl/statistics.h"
 
 Texture::Texture(int width, int height, GLint internalFormat, GLint dataFormat, GLenum type, bool filter)
     : width(width), height(height), dataFormat(dataFormat), type(type), success(false) {
@@ -26,13 +27,13 @@ Texture::Texture(int width, int height, GLint internalFormat, GLint dataFormat,
 Texture::~Texture() { glDeleteTextures(1, &id); }
 
 void Texture::update(const void* data) {
-    glBindTexture(GL_TEXTURE_2D, id);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, dataFormat, type, data);
+    GLCALL(glBindTexture(GL_TEXTURE_2D, id));
+    GLCALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, dataFormat, type, data));
 }
 
 void Texture::bind(int sampler) {
-    glActiveTexture(GL_TEXTURE0 + sampler);
-    glBindTexture(GL_TEXTURE_2D, id);
+    GLCALL(glActiveTexture(GL_TEXTURE0 + sampler));
+    GLCALL(glBindTexture(GL_TEXTURE_2D, id));
 }
 
 GLuint Texture::get() { return id; }
@@ -6,6 +6,7 @@ class Uniform {
     GLuint id;
 
    public:
+    Uniform();
     Uniform(GLuint id);
     ~Uniform();
 
@@ -0,0 +1,22 @@
+#include "uniform_buffer.h"
+#include "renderer/opengl/statistics.h"
+
+UniformBuffer::UniformBuffer(size_t size, GLuint binding) : binding(binding) {
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_UNIFORM_BUFFER, id);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, id);
+}
+
+UniformBuffer::~UniformBuffer() { glDeleteBuffers(1, &id); }
+
+void UniformBuffer::update(int size, const void* data) {
+    GLCALL(glBindBuffer(GL_UNIFORM_BUFFER, id));
+    GLCALL(glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data));
+}
+
+GLuint UniformBuffer::getBinding() { return binding; }
+
+GLuint UniformBuffer::get() { return id; }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+#include <opengl.h>
+#include <cstddef>
+
+class UniformBuffer {
+    GLuint id;
+    GLuint binding;
+
+   public:
+    UniformBuffer(size_t size, GLuint binding);
+    ~UniformBuffer();
+
+    void update(int size, const void* data);
+    GLuint getBinding();
+    GLuint get();
+};
\ No newline at end of file
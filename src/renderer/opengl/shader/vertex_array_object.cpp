@@ -1,4 +1,5 @@
 #include "vertex_array_object.h"
+#include "renderer/opengl/statistics.h"
 
 GLuint VertexArrayObject::currentId = 0;
 
@@ -9,7 +10,7 @@ VertexArrayObject::~VertexArrayObject() { glDeleteVertexArrays(1, &id); }
 void VertexArrayObject::bind() {
     if (currentId != id) {
         currentId = id;
-        glBindVertexArray(id);
+        GLCALL(glBindVertexArray(id));
     }
 }
 
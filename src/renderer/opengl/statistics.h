@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+
+struct GLStatistics {
+    uint32_t calls = 0;
+    uint32_t drawCalls = 0;
+};
+
+// Collected for currently rendered frame, reset by OpenGL::render
+inline GLStatistics glStatistics;
+
+// Counts OpenGL call issued by the renderer, eg. GLCALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+#define GLCALL(call) (++glStatistics.calls, call)
@@ -1,7 +1,12 @@
 #include "adpcm.h"
+#include <algorithm>
 #include <cassert>
 #include "tables.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace ADPCM {
 int filterTablePos[5] = {0, 60, 115, 98, 122};
 int filterTableNeg[5] = {0, 0, -52, -55, -60};
@@ -13,10 +18,7 @@ int16_t clamp_16bit(int32_t sample) {
     return (int16_t)sample;
 }
 
-std::vector<int16_t> decode(uint8_t buffer[16], int32_t prevSample[2]) {
-    std::vector<int16_t> decoded;
-    decoded.reserve(28);
-
+void decode(const uint8_t buffer[16], int32_t prevSample[2], int16_t decoded[28]) {
     // Read ADPCM header
     auto shift = buffer[0] & 0x0f;
     auto filter = (buffer[0] & 0x70) >> 4;  // 0x40 for xa adpcm
@@ -47,129 +49,161 @@ std::vector<int16_t> decode(uint8_t buffer[16], int32_t prevSample[2]) {
         sample += (prevSample[0] * filterPos + prevSample[1] * filterNeg + 32) / 64;
 
         // clamp to -0x8000 +0x7fff
-        decoded.push_back(clamp_16bit(sample));
+        decoded[n] = clamp_16bit(sample);
 
         // Move previous samples forward
         prevSample[1] = prevSample[0];
         prevSample[0] = sample;
     }
-
-    return decoded;
 }
 
-// Separate buffers and counters for left and right channels
-// TODO: Come up with better solution. Are two buffers really necessary?
-int16_t ringbuf[2][0x20] = {};
-int p[2] = {};
-int sixstep[2] = {6, 6};
+namespace {
+// Decoder state of one XA channel, mono streams use left channel
+struct XAChannel {
+    int32_t prevSample[2] = {};
 
-template <int ch>
-int16_t doZigzag(int p, int table) {
-    int32_t sum = 0;
-    for (int i = 1; i < 29; i++) {
-        sum += (ringbuf[ch][(p - i) & 0x1f] * zigzagTables[table][i]) / 0x8000;
-    }
-    return clamp_16bit(sum);
-}
+    // Last 32 samples for the zigzag interpolation, stored twice so the 28 sample window
+    // ending at any position is contiguous. Padded for the vector loads.
+    alignas(32) int16_t history[32 * 2 + 8] = {};
+    int position = 0;
+    int sixstep = 6;
+};
 
-// sampleRate == false - 37800Hz
-// sampleRate == true  - 18900Hz - double output samples
-template <int ch>
-void interpolate(int16_t sample, std::vector<int16_t>& output, bool sampleRate = false) {
-    ringbuf[ch][p[ch]++ & 0x1f] = sample;
+XAChannel xaChannels[2];
 
-    if (--sixstep[ch] == 0) {
-        sixstep[ch] = 6;
+// zigzagTables reversed to the history order (oldest sample first) and padded with zeros to 32 taps
+struct ZigzagKernels {
+    alignas(32) int32_t taps[7][32];
+
+    ZigzagKernels() {
         for (int table = 0; table < 7; table++) {
-            int16_t v = doZigzag<ch>(p[ch], table);
-            output.push_back(v);
-            if (sampleRate) output.push_back(v);
+            for (int j = 0; j < 32; j++) {
+                taps[table][j] = j < 28 ? zigzagTables[table][28 - j] : 0;
+            }
         }
     }
+};
+
+const ZigzagKernels zigzagKernels;
+
+// window points to 28 consecutive samples, oldest first
+int16_t doZigzag(const int16_t* window, int table) {
+    const int32_t* taps = zigzagKernels.taps[table];
+#ifdef __AVX2__
+    __m256i sum = _mm256_setzero_si256();
+    for (int j = 0; j < 32; j += 8) {
+        __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(window + j)));
+        __m256i product = _mm256_mullo_epi32(samples, _mm256_load_si256((const __m256i*)(taps + j)));
+
+        // Division by 0x8000 rounds towards zero
+        __m256i bias = _mm256_and_si256(_mm256_srai_epi32(product, 31), _mm256_set1_epi32(0x7fff));
+        sum = _mm256_add_epi32(sum, _mm256_srai_epi32(_mm256_add_epi32(product, bias), 15));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return clamp_16bit(_mm_cvtsi128_si32(half));
+#else
+    int32_t sum = 0;
+    for (int j = 0; j < 28; j++) {
+        sum += (window[j] * taps[j]) / 0x8000;
+    }
+    return clamp_16bit(sum);
+#endif
 }
 
-enum class Channel { mono, left, right };
-
-template <Channel channel>
-std::vector<int16_t> decodePacket(uint8_t buffer[128], int32_t prevSample[2], bool sampleRate) {
-    std::vector<int16_t> decoded;
+// Expands 28 samples of given block to 16bit and applies the header shift.
+// 4bit: 8 blocks per sound group, 8bit: 4 blocks per sound group
+template <bool eightBit>
+void expandBlock(const uint8_t group[128], int block, int32_t expanded[28]) {
+    int shift = group[4 + block] & 0x0f;
+    if (shift > 12) shift = 9;
 
-    std::vector<int> blocks;
-    if (channel == Channel::mono) {
-        blocks = {0, 1, 2, 3, 4, 5, 6, 7};
-    } else if (channel == Channel::left) {
-        blocks = {0, 2, 4, 6};
-    } else if (channel == Channel::right) {
-        blocks = {1, 3, 5, 7};
+    for (int n = 0; n < 28; n++) {
+        int16_t sample;
+        if (eightBit) {
+            sample = group[0x10 + n * 4 + block] << 8;
+        } else {
+            sample = ((group[0x10 + n * 4 + block / 2] >> ((block % 2) * 4)) & 0xf) << 12;
+        }
+        expanded[n] = (int32_t)sample >> shift;
     }
+}
 
-    for (auto block : blocks) {
-        // Read ADPCM header
-        auto shift = buffer[4 + block] & 0x0f;
-        auto filter = (buffer[4 + block] & 0x30) >> 4;
-        if (shift > 12) shift = 9;
-
-        auto filterPos = filterTablePos[filter];
-        auto filterNeg = filterTableNeg[filter];
+enum Output { Left = 1 << 0, Right = 1 << 1, Both = Left | Right };
 
-        for (auto n = 0; n < 28; n++) {
-            // Read currently decoded nibble
-            uint32_t word = buffer[0x10 + n * 4 + 0];
-            word |= buffer[0x10 + n * 4 + 1] << 8;
-            word |= buffer[0x10 + n * 4 + 2] << 16;
-            word |= buffer[0x10 + n * 4 + 3] << 24;
+// Filters expanded block and converts 37800Hz to 44100Hz (6 input samples -> 7 output samples) in the same pass.
+// 18900Hz is output twice. Returns number of samples written to output.
+template <Output out>
+size_t decodeBlock(XAChannel& ch, const int32_t expanded[28], int filter, bool halfRate, std::pair<int16_t, int16_t>* output) {
+    const int filterPos = filterTablePos[filter];
+    const int filterNeg = filterTableNeg[filter];
+    size_t count = 0;
 
-            int16_t nibble = (word >> (block * 4)) & 0xf;
+    for (int n = 0; n < 28; n++) {
+        int32_t sample = expanded[n] + (ch.prevSample[0] * filterPos + ch.prevSample[1] * filterNeg + 32) / 64;
 
-            // Extend 4bit sample to 16bit
-            int32_t sample = (int32_t)(int16_t)(nibble << 12);
+        // Unclamped sample is used for prediction
+        ch.prevSample[1] = ch.prevSample[0];
+        ch.prevSample[0] = sample;
 
-            // Shift right by value in header
-            sample >>= shift;
+        int index = ch.position++ & 0x1f;
+        ch.history[index] = ch.history[index + 32] = clamp_16bit(sample);
 
-            // Mix previous samples
-            sample += (prevSample[0] * filterPos + prevSample[1] * filterNeg + 32) / 64;
+        if (--ch.sixstep != 0) continue;
+        ch.sixstep = 6;
 
-            // clamp to -0x8000 +0x7fff
-            // Intepolate 37800Hz to 44100Hz
-            if (channel == Channel::mono || channel == Channel::left) {
-                interpolate<0>(clamp_16bit(sample), decoded, sampleRate);
-            } else {
-                interpolate<1>(clamp_16bit(sample), decoded, sampleRate);
+        const int16_t* window = &ch.history[index + 32 - 27];
+        for (int table = 0; table < 7; table++) {
+            int16_t v = doZigzag(window, table);
+            for (int i = 0; i < (halfRate ? 2 : 1); i++, count++) {
+                if (out & Left) output[count].first = v;
+                if (out & Right) output[count].second = v;
             }
-
-            // Move previous samples forward
-            prevSample[1] = prevSample[0];
-            prevSample[0] = sample;
         }
     }
-
-    return decoded;
+    return count;
 }
 
-std::vector<std::pair<int16_t, int16_t>> decodeXA(uint8_t buffer[128 * 18], cd::Codinginfo codinginfo) {
-    static int32_t prevSampleLeft[2] = {};
-    static int32_t prevSampleRight[2] = {};
+template <bool eightBit>
+size_t decodeSector(const uint8_t* buffer, cd::Codinginfo codinginfo, std::pair<int16_t, int16_t>* output) {
+    const int blocks = eightBit ? 4 : 8;
+    const bool halfRate = codinginfo.sampleRate;
+    alignas(32) int32_t expanded[28];
+    size_t count = 0;
 
-    std::vector<std::pair<int16_t, int16_t>> frame;
+    // Each sector contains of 18 128-byte sound groups
+    for (int group = 0; group < 18; group++) {
+        const uint8_t* data = buffer + group * 128;
 
-    // Each sector contains of 18 128-byte portions
-    for (int packet = 0; packet < 18; packet++) {
         if (codinginfo.stereo) {
-            auto l = decodePacket<Channel::left>(buffer + packet * 128, prevSampleLeft, codinginfo.sampleRate);
-            auto r = decodePacket<Channel::right>(buffer + packet * 128, prevSampleRight, codinginfo.sampleRate);
-
-            for (int i = 0; i < l.size(); i++) {
-                frame.emplace_back(l[i], r[i]);
+            // Even blocks are left channel, odd are right. Channel positions are tracked separately,
+            // they stay in sync unless stream changed from mono to stereo.
+            size_t left = count, right = count;
+            for (int block = 0; block < blocks; block += 2) {
+                expandBlock<eightBit>(data, block, expanded);
+                left += decodeBlock<Left>(xaChannels[0], expanded, (data[4 + block] & 0x30) >> 4, halfRate, output + left);
+
+                expandBlock<eightBit>(data, block + 1, expanded);
+                right += decodeBlock<Right>(xaChannels[1], expanded, (data[5 + block] & 0x30) >> 4, halfRate, output + right);
             }
+            count = std::min(left, right);
         } else {
-            auto mono = decodePacket<Channel::mono>(buffer + packet * 128, prevSampleLeft, codinginfo.sampleRate);
-            for (auto sample : mono) {
-                frame.emplace_back(sample, sample);
+            for (int block = 0; block < blocks; block++) {
+                expandBlock<eightBit>(data, block, expanded);
+                count += decodeBlock<Both>(xaChannels[0], expanded, (data[4 + block] & 0x30) >> 4, halfRate, output + count);
             }
         }
     }
+    return count;
+}
+};  // namespace
 
-    return frame;
+size_t decodeXA(const uint8_t buffer[128 * 18], cd::Codinginfo codinginfo, std::pair<int16_t, int16_t> output[XA_MAX_SAMPLES]) {
+    if (codinginfo.bits) {
+        return decodeSector<true>(buffer, codinginfo, output);
+    } else {
+        return decodeSector<false>(buffer, codinginfo, output);
+    }
 }
 }  // namespace ADPCM
@@ -1,5 +1,7 @@
 #pragma once
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 #include "utils/cd.h"
 
 namespace ADPCM {
@@ -17,6 +19,13 @@ enum Flag {
                          // 1 - Load currentAddress to repeatAddress
                          // 0 - Nothing
 };
-std::vector<int16_t> decode(uint8_t buffer[16], int32_t prevSample[2]);
-std::vector<std::pair<int16_t, int16_t>> decodeXA(uint8_t buffer[128 * 18], cd::Codinginfo codinginfo);
+// Decodes 16 byte block into 28 samples
+void decode(const uint8_t buffer[16], int32_t prevSample[2], int16_t decoded[28]);
+
+// Stereo samples produced from one XA sector at most (mono, 18900Hz)
+const size_t XA_MAX_SAMPLES = 18 * 8 * 28 / 6 * 7 * 2;
+
+// Decodes 4 or 8bit XA-ADPCM sector (18 sound groups) and converts it to 44100Hz.
+// Returns number of samples written to output
+size_t decodeXA(const uint8_t buffer[128 * 18], cd::Codinginfo codinginfo, std::pair<int16_t, int16_t> output[XA_MAX_SAMPLES]);
 };  // namespace ADPCM
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "resampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const double PI = 3.14159265358979323846;
+const double CUTOFF = 0.95;
+
+double sinc(double x) {
+    if (x == 0.0) return 1.0;
+    return std::sin(PI * x) / (PI * x);
+}
+
+// Blackman window, x in range 0..1
+double window(double x) { return 0.42 - 0.5 * std::cos(2.0 * PI * x) + 0.08 * std::cos(4.0 * PI * x); }
+};  // namespace
+
+Resampler::Resampler() : kernel(PHASES + 1) {
+    // Tap k of phase p is applied to input frame at (k - TAPS / 2 + 1) relative to integer position,
+    // fractional part of position equals p / PHASES
+    for (int p = 0; p <= PHASES; p++) {
+        double frac = (double)p / PHASES;
+        double sum = 0.0;
+        for (int k = 0; k < TAPS; k++) {
+            double x = (k - TAPS / 2 + 1) - frac;
+            double w = window((x + TAPS / 2) / TAPS);
+            kernel[p][k] = (float)(CUTOFF * sinc(CUTOFF * x) * w);
+            sum += kernel[p][k];
+        }
+        // Unity gain for DC
+        for (int k = 0; k < TAPS; k++) {
+            kernel[p][k] = (float)(kernel[p][k] / sum);
+        }
+    }
+    reset();
+}
+
+void Resampler::setRatio(double ratio) { this->ratio = ratio; }
+
+void Resampler::reset() {
+    for (auto& h : history) {
+        h.assign(TAPS, 0.f);
+    }
+    position = TAPS / 2;
+}
+
+void Resampler::process(const int16_t* input, size_t frames, std::vector<int16_t>& output) {
+    for (size_t i = 0; i < frames; i++) {
+        history[0].push_back(input[i * 2 + 0]);
+        history[1].push_back(input[i * 2 + 1]);
+    }
+
+    const double step = 1.0 / ratio;
+    const size_t size = history[0].size();
+
+    // Last tap must be inside history
+    while (position + TAPS / 2 < size) {
+        size_t index = (size_t)position;
+        float frac = (float)((position - index) * PHASES);
+        int phase = (int)frac;
+        float blend = frac - phase;
+
+        const float* l = &history[0][index - TAPS / 2 + 1];
+        const float* r = &history[1][index - TAPS / 2 + 1];
+        float sumLeft = 0.f, sumRight = 0.f;
+        for (int k = 0; k < TAPS; k++) {
+            float c = kernel[phase][k] + (kernel[phase + 1][k] - kernel[phase][k]) * blend;
+            sumLeft += l[k] * c;
+            sumRight += r[k] * c;
+        }
+
+        output.push_back((int16_t)std::clamp(std::lround(sumLeft), (long)INT16_MIN, (long)INT16_MAX));
+        output.push_back((int16_t)std::clamp(std::lround(sumRight), (long)INT16_MIN, (long)INT16_MAX));
+        position += step;
+    }
+
+    // Keep TAPS frames for next call
+    size_t consumed = size - TAPS;
+    for (auto& h : history) {
+        h.erase(h.begin(), h.begin() + consumed);
+    }
+    position -= consumed;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Polyphase windowed-sinc resampler for interleaved stereo 16bit samples.
+// Ratio (output rate / input rate) can be changed between calls without discontinuities.
+class Resampler {
+   public:
+    static const int TAPS = 16;
+    static const int PHASES = 256;
+
+    Resampler();
+    void setRatio(double ratio);
+    double getRatio() const { return ratio; }
+
+    // Appends resampled frames to output
+    void process(const int16_t* input, size_t frames, std::vector<int16_t>& output);
+    void reset();
+
+   private:
+    // Kernel is designed for ratios close to 1, cutoff slightly below Nyquist of the input
+    std::vector<std::array<float, TAPS>> kernel;  // PHASES + 1 entries for interpolation between phases
+
+    double ratio = 1.0;
+    double position;  // Position of next output frame in history, in input frames
+
+    std::vector<float> history[2];  // TAPS frames of previous input followed by current input
+};
@@ -0,0 +1,39 @@
+#include "sound.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "resampler.h"
+
+namespace Sound {
+RingBuffer<Frame> buffer(BUFFER_FRAMES);
+
+namespace {
+std::atomic<uint64_t> overrunFrames{0};
+
+// Dynamic rate control - resampling ratio is slightly adjusted to keep buffer around TARGET_FRAMES,
+// which absorbs difference between emulated and host clocks without audible pitch change
+const size_t TARGET_FRAMES = 2048;
+const double MAX_RATIO_DEVIATION = 0.01;
+
+Resampler resampler;
+std::vector<int16_t> resampled;
+}  // namespace
+
+void clearBuffer() { buffer.clear(); }
+
+void appendBuffer(const int16_t* samples, size_t count) {
+    double fill = ((double)buffer.size() - TARGET_FRAMES) / TARGET_FRAMES;
+    resampler.setRatio(1.0 - std::clamp(fill, -1.0, 1.0) * MAX_RATIO_DEVIATION);
+
+    resampled.clear();
+    resampler.process(samples, count / CHANNELS, resampled);
+
+    size_t frames = resampled.size() / CHANNELS;
+    size_t written = buffer.push(reinterpret_cast<const Frame*>(resampled.data()), frames);
+    if (written < frames) {
+        overrunFrames.fetch_add(frames - written, std::memory_order_relaxed);
+    }
+}
+
+uint64_t overruns() { return overrunFrames.load(std::memory_order_relaxed); }
+};  // namespace Sound
@@ -1,12 +1,20 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
-#include <deque>
-#include <iterator>
-#include <mutex>
+#include "utils/ring_buffer.h"
 
 namespace Sound {
-extern std::deque<uint16_t> buffer;
-extern std::mutex audioMutex;
+const int CHANNELS = 2;
+const size_t BUFFER_FRAMES = 8192;
+
+struct Frame {
+    int16_t left;
+    int16_t right;
+};
+static_assert(sizeof(Frame) == CHANNELS * sizeof(int16_t));
+
+// Filled by emulation thread, drained by audio callback
+extern RingBuffer<Frame> buffer;
 
 void init();
 void play();
@@ -14,13 +22,10 @@ void stop();
 void close();
 void clearBuffer();
 
-template <typename Iterator>
-void appendBuffer(const Iterator& start, const Iterator& end) {
-    std::unique_lock<std::mutex> lock(audioMutex);
+// Frames that did not fit into the buffer are dropped
+void appendBuffer(const int16_t* samples, size_t count);
 
-    if (buffer.size() > 512 * 32) {
-        buffer.clear();
-    }
-    buffer.insert(buffer.end(), start, end);
-}
+// Number of frames dropped because buffer was full / missing when audio device requested them
+uint64_t overruns();
+uint64_t underruns();
 };  // namespace Sound
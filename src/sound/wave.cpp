@@ -1,22 +1,32 @@
 #include "wave.h"
+#include <chrono>
 #include <cstring>
-#include <cstdio> // for FILE, fwrite, fclose
 
 namespace wave {
+namespace {
+const int bitPerSample = 16;
+const int sampleRate = 44100;
+};  // namespace
+
 bool writeToFile(const std::vector<uint16_t>& buffer, const char* filename, int channels) {
-    FILE* f = fopen(filename, "wb");
-    if (!f) {
+    Writer writer;
+    if (!writer.open(filename, channels)) {
         return false;
     }
-    auto wstr = [&](const char* str) { fwrite(str, 1, strlen(str), f); };
-    auto w32 = [f](uint32_t i) { fwrite(&i, sizeof(i), 1, f); };
-    auto w16 = [f](uint16_t i) { fwrite(&i, sizeof(i), 1, f); };
+    bool written = writer.write(reinterpret_cast<const int16_t*>(buffer.data()), buffer.size());
+    writer.close();
+    return written;
+}
 
-    const int bitPerSample = 16;
-    const int sampleRate = 44100;
+Writer::~Writer() { close(); }
+
+void Writer::writeHeader() {
+    auto wstr = [&](const char* str) { fwrite(str, 1, strlen(str), f); };
+    auto w32 = [&](uint32_t i) { fwrite(&i, sizeof(i), 1, f); };
+    auto w16 = [&](uint16_t i) { fwrite(&i, sizeof(i), 1, f); };
 
     wstr("RIFF");
-    w32((buffer.size() * bitPerSample / 8) + 36);
+    w32(dataSize + 36);
 
     wstr("WAVE");
     wstr("fmt ");
@@ -29,12 +39,87 @@ bool writeToFile(const std::vector<uint16_t>& buffer, const char* filename, int
     w16(bitPerSample);
 
     wstr("data");
-    w32(buffer.size() * bitPerSample / 8);
-    for (uint16_t s : buffer) {
-        w16(s);
+    w32(dataSize);
+}
+
+bool Writer::open(const char* filename, int channels) {
+    close();
+    f = fopen(filename, "wb");
+    if (!f) {
+        return false;
     }
+    this->channels = channels;
+    dataSize = 0;
+    writeHeader();  // Sizes are filled in on close
+    return true;
+}
+
+bool Writer::write(const int16_t* samples, size_t count) {
+    if (!f) return false;
 
+    size_t written = fwrite(samples, sizeof(int16_t), count, f);
+    dataSize += written * sizeof(int16_t);
+    return written == count;
+}
+
+void Writer::close() {
+    if (!f) return;
+
+    fseek(f, 0, SEEK_SET);
+    writeHeader();
     fclose(f);
+    f = nullptr;
+}
+
+Recorder::~Recorder() { stop(); }
+
+bool Recorder::start(const std::string& filename) {
+    stop();
+    if (!writer.open(filename.c_str())) {
+        return false;
+    }
+
+    samplesWritten = 0;
+    samplesDropped = 0;
+    writeFailed = false;
+    writerThreadExit = false;
+    writerThread = std::thread(&Recorder::writerThreadFunc, this);
     return true;
 }
-};  // namespace wave
\ No newline at end of file
+
+void Recorder::stop() {
+    if (!writerThread.joinable()) return;
+
+    writerThreadExit = true;
+    writerThread.join();
+    writer.close();
+}
+
+void Recorder::write(const int16_t* samples, size_t count) {
+    if (!isRecording()) return;
+
+    size_t written = buffer.push(samples, count);
+    samplesWritten += written;
+    samplesDropped += count - written;
+}
+
+void Recorder::writerThreadFunc() {
+    std::vector<int16_t> block(16384);
+
+    while (true) {
+        // Exit flag is checked before draining, samples pushed before stop() are always written
+        bool exit = writerThreadExit;
+
+        size_t count = buffer.pop(block.data(), block.size());
+        if (count > 0) {
+            if (!writer.write(block.data(), count)) {
+                writeFailed = true;
+            }
+            continue;
+        }
+
+        if (exit) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+};  // namespace wave
@@ -1,7 +1,59 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
 #include <vector>
+#include "utils/ring_buffer.h"
 
 namespace wave {
 bool writeToFile(const std::vector<uint16_t>& buffer, const char* filename, int channels = 2);
+
+// 16bit 44100Hz WAV file written incrementally, header sizes are updated on close()
+class Writer {
+    FILE* f = nullptr;
+    int channels = 2;
+    uint32_t dataSize = 0;
+
+    void writeHeader();
+
+   public:
+    ~Writer();
+    bool open(const char* filename, int channels = 2);
+    bool write(const int16_t* samples, size_t count);
+    void close();
+    bool isOpen() const { return f != nullptr; }
+};
+
+// Streams interleaved stereo samples to WAV file on a background thread.
+// write() only copies samples to a lock-free ring buffer and never waits for disk I/O,
+// samples that do not fit (writer thread stalled for over ~3 seconds) are dropped.
+class Recorder {
+    static const size_t BUFFER_SIZE = 1 << 18;
+
+    RingBuffer<int16_t> buffer{BUFFER_SIZE};
+    Writer writer;
+    std::thread writerThread;
+    std::atomic<bool> writerThreadExit{false};
+    std::atomic<bool> writeFailed{false};
+
+    uint64_t samplesWritten = 0;
+    uint64_t samplesDropped = 0;
+
+    void writerThreadFunc();
+
+   public:
+    ~Recorder();
+    bool start(const std::string& filename);
+    void stop();  // Writes remaining samples and finalizes the file
+    bool isRecording() const { return writerThread.joinable(); }
+    bool failed() const { return writeFailed; }
+
+    // Emulation thread
+    void write(const int16_t* samples, size_t count);
+
+    double seconds() const { return samplesWritten / 44100.0 / 2; }
+    uint64_t dropped() const { return samplesDropped; }
 };
+};  // namespace wave
@@ -334,12 +334,13 @@ void System::singleStep() {
     state = State::pause;
 
     dma->step();
-    cdrom->step();
+    cdrom->step(3);
     timer[0]->step(3);
     timer[1]->step(3);
     timer[2]->step(3);
     controller->step();
-    spu->step(cdrom.get());
+    spu->flush();
+    spu->render(1);
 
     if (gpu->emulateGpuCycles(3)) {
         interrupt->trigger(interrupt::VBLANK);
@@ -371,6 +372,7 @@ void System::emulateFrame() {
     ioLogList.clear();
 #endif
     cpu->gte.log.clear();
+    cpu->gte.updateHooks();  // 3D screenshot and free camera are toggled between frames
 
     if (GpuDrawList::currentFrame == 0) {
         gpu->prevVram = gpu->vram;
@@ -399,28 +401,24 @@ void System::emulateFrame() {
         }
 
         dma->step();
-        cdrom->step();
+        cdrom->step(systemCycles);
         timer[0]->step(systemCycles);
         timer[1]->step(systemCycles);
         timer[2]->step(systemCycles);
 
         static float spuCounter = 0;
 
-        float magicNumber = 1.575f;
-        if (!gpu->isNtsc()) {
-            // Hack to prevent crackling audio on PAL games
-            // Note - this overclocks SPU clock, bugs might appear.
-            magicNumber *= 50.f / 60.f;
-        }
+        // Host rate mismatch is handled by resampler in Sound::appendBuffer
+        const float magicNumber = 1.575f;
         spuCounter += (float)systemCycles / magicNumber / (float)0x300;
         if (spuCounter >= 1.f) {
-            spu->step(cdrom.get());
+            spu->advance();
             spuCounter -= 1.0f;
         }
 
         if (spu->bufferReady) {
-            spu->bufferReady = false;
-            Sound::appendBuffer(spu->audioBuffer.begin(), spu->audioBuffer.end());
+            Sound::appendBuffer(spu->audioBuffer.data(), spu->audioBufferPos);
+            spu->clearAudioBuffer();
         }
 
         controller->step();
@@ -431,7 +429,7 @@ void System::emulateFrame() {
         }
 
         // TODO: Move this code to Timer class
-        if (gpu->gpuLine > gpu::LINE_VBLANK_START_NTSC) {
+        if (gpu->gpuLine > gpu->lineVblankStart()) {
             auto& t = *timer[1];
             if (t.mode.syncEnabled) {
                 using modes = device::timer::CounterMode::SyncMode1;
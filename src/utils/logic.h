@@ -1,6 +1,9 @@
 #pragma once
 #include <algorithm>
 #include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 template <size_t from, size_t to>
 bool or_range(uint32_t v) {
@@ -17,6 +20,17 @@ bool or_range(uint32_t v) {
     return result;
 }
 
+// Index of lowest set bit, n must not be 0
+inline int lowestSetBit(uint32_t n) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, n);
+    return index;
+#else
+    return __builtin_ctz(n);
+#endif
+}
+
 /**
  * Sign extend integer to bigger size.
  * eg. 11 bit int to int16_t
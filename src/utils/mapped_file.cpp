@@ -0,0 +1,75 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+std::unique_ptr<MappedFile> MappedFile::open(const std::string& path) {
+    auto mapped = std::unique_ptr<MappedFile>(new MappedFile());
+
+    mapped->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mapped->file == INVALID_HANDLE_VALUE) {
+        mapped->file = nullptr;
+        return {};
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mapped->file, &size) || size.QuadPart == 0) {
+        return {};
+    }
+
+    mapped->mapping = CreateFileMappingA(mapped->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapped->mapping == nullptr) {
+        return {};
+    }
+
+    mapped->ptr = static_cast<const uint8_t*>(MapViewOfFile(mapped->mapping, FILE_MAP_READ, 0, 0, 0));
+    if (mapped->ptr == nullptr) {
+        return {};
+    }
+    mapped->length = (size_t)size.QuadPart;
+    return mapped;
+}
+
+MappedFile::~MappedFile() {
+    if (ptr != nullptr) UnmapViewOfFile(ptr);
+    if (mapping != nullptr) CloseHandle(mapping);
+    if (file != nullptr) CloseHandle(file);
+}
+#else
+std::unique_ptr<MappedFile> MappedFile::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return {};
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return {};
+    }
+
+    // Mapping stays valid after the descriptor is closed
+    void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return {};
+    }
+
+    auto mapped = std::unique_ptr<MappedFile>(new MappedFile());
+    mapped->ptr = static_cast<const uint8_t*>(addr);
+    mapped->length = (size_t)st.st_size;
+    return mapped;
+}
+
+MappedFile::~MappedFile() {
+    if (ptr != nullptr) munmap(const_cast<uint8_t*>(ptr), length);
+}
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Lock-free single producer, single consumer ring buffer.
+// push() must be called only from one thread and pop() only from the other one.
+template <typename T>
+class RingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "RingBuffer copies elements with memcpy");
+
+    std::vector<T> data;
+    size_t mask;
+
+    // Positions only grow, index into data is position & mask
+    alignas(64) std::atomic<size_t> head{0};  // Written by producer
+    alignas(64) std::atomic<size_t> tail{0};  // Written by consumer
+    std::atomic<size_t> clearPosition{0};     // Elements before this position are dropped by consumer
+
+    static size_t roundUp(size_t v) {
+        size_t power = 1;
+        while (power < v) power <<= 1;
+        return power;
+    }
+
+    // Copies count elements between ring at position pos and linear buffer, wrapping if needed
+    void copyIn(size_t pos, const uint8_t* src, size_t count) {
+        size_t index = pos & mask;
+        size_t first = std::min(count, data.size() - index);
+        memcpy(&data[index], src, first * sizeof(T));
+        memcpy(&data[0], src + first * sizeof(T), (count - first) * sizeof(T));
+    }
+
+    void copyOut(size_t pos, uint8_t* dst, size_t count) const {
+        size_t index = pos & mask;
+        size_t first = std::min(count, data.size() - index);
+        memcpy(dst, &data[index], first * sizeof(T));
+        memcpy(dst + first * sizeof(T), &data[0], (count - first) * sizeof(T));
+    }
+
+    size_t popBytes(uint8_t* dst, size_t count) {
+        // Clear position is loaded before head, so it never points past it
+        size_t c = clearPosition.load(std::memory_order_acquire);
+        size_t t = std::max(tail.load(std::memory_order_relaxed), c);
+        size_t h = head.load(std::memory_order_acquire);
+
+        size_t read = std::min(count, h - t);
+        copyOut(t, dst, read);
+
+        tail.store(t + read, std::memory_order_release);
+        return read;
+    }
+
+   public:
+    // Capacity is rounded up to power of two
+    explicit RingBuffer(size_t capacity) : data(roundUp(capacity)), mask(data.size() - 1) {}
+
+    size_t capacity() const { return data.size(); }
+
+    // Elements waiting for consumer, cleared ones are not counted
+    size_t size() const {
+        size_t c = clearPosition.load(std::memory_order_acquire);
+        size_t t = std::max(tail.load(std::memory_order_acquire), c);
+        return head.load(std::memory_order_acquire) - t;
+    }
+
+    // Producer side, returns number of elements written (less than count if full)
+    size_t push(const T* src, size_t count) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t t = tail.load(std::memory_order_acquire);
+
+        size_t written = std::min(count, data.size() - (h - t));
+        copyIn(h, reinterpret_cast<const uint8_t*>(src), written);
+
+        head.store(h + written, std::memory_order_release);
+        return written;
+    }
+
+    // Consumer side, returns number of elements read (less than count if empty)
+    size_t pop(T* dst, size_t count) { return popBytes(reinterpret_cast<uint8_t*>(dst), count); }
+
+    // Same as above for untyped buffers (SDL audio callback), dst has room for count elements of T
+    size_t pop(void* dst, size_t count) { return popBytes(static_cast<uint8_t*>(dst), count); }
+
+    // Drops elements pushed so far, consumer skips them on next pop().
+    // Elements pushed after clear() returns are kept, so it is safe to call from producer side.
+    void clear() { clearPosition.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+};
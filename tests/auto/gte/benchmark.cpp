@@ -0,0 +1,260 @@
+#include "benchmark.h"
+#include <fmt/core.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <map>
+#include "cpu/gte/gte.h"
+#include "utils/file.h"
+
+namespace {
+// Limits cached states per opcode, so they stay in CPU cache during the measurement
+const size_t maxSamples = 1024;
+
+// Opcode loops are repeated and the fastest run is taken to filter out scheduling noise
+const int repeats = 5;
+
+struct Sample {
+    std::array<uint32_t, 64> regs;
+    gte::Command cmd;
+
+    Sample() : cmd(0) {}
+};
+
+struct Opcode {
+    std::string name;
+    std::vector<Sample> samples;
+    double nsPerOp = 0.0;
+};
+
+// SXYP is a FIFO push, IRGB overwrites IR1-3, ORGB and LZCR are read only
+const std::vector<int> restorableRegisters = [] {
+    std::vector<int> regs;
+    for (int i = 0; i < 64; i++) {
+        if (i == 15 || i == 28 || i == 29 || i == 31) continue;
+        regs.push_back(i);
+    }
+    return regs;
+}();
+
+const char* mnemonic(int cmd) {
+    switch (cmd) {
+        case 0x01: return "RTPS";
+        case 0x06: return "NCLIP";
+        case 0x0c: return "OP";
+        case 0x10: return "DPCS";
+        case 0x11: return "INTPL";
+        case 0x12: return "MVMVA";
+        case 0x13: return "NCDS";
+        case 0x14: return "CDP";
+        case 0x16: return "NCDT";
+        case 0x1b: return "NCCS";
+        case 0x1c: return "CC";
+        case 0x1e: return "NCS";
+        case 0x20: return "NCT";
+        case 0x28: return "SQR";
+        case 0x29: return "DCPL";
+        case 0x2a: return "DPCT";
+        case 0x2d: return "AVSZ3";
+        case 0x2e: return "AVSZ4";
+        case 0x30: return "RTPT";
+        case 0x3d: return "GPF";
+        case 0x3e: return "GPL";
+        case 0x3f: return "NCCT";
+        default: return nullptr;
+    }
+}
+
+// MVMVA is split by its matrix, vector and translation selection
+uint32_t opcodeKey(const gte::Command& cmd) {
+    uint32_t key = cmd.cmd << 6;
+    if (cmd.cmd == 0x12) {
+        key |= (cmd.mvmvaMultiplyMatrix << 4) | (cmd.mvmvaMultiplyVector << 2) | cmd.mvmvaTranslationVector;
+    }
+    return key;
+}
+
+std::string opcodeName(const gte::Command& cmd) {
+    const char* name = mnemonic(cmd.cmd);
+    if (name == nullptr) {
+        return fmt::format("0x{:02x}", (int)cmd.cmd);
+    }
+    if (cmd.cmd == 0x12) {
+        return fmt::format("{} (mx={}, vx={}, tx={})", name, (int)cmd.mvmvaMultiplyMatrix, (int)cmd.mvmvaMultiplyVector,
+                           (int)cmd.mvmvaTranslationVector);
+    }
+    return name;
+}
+
+std::string escapeJson(const std::string& str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+void saveState(GTE& gte, Sample& sample) {
+    for (int i = 0; i < 64; i++) {
+        sample.regs[i] = gte.read(i);
+    }
+}
+
+void loadState(GTE& gte, const Sample& sample) {
+    for (int reg : restorableRegisters) {
+        gte.write(reg, sample.regs[reg]);
+    }
+}
+
+template <typename F>
+double measure(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+template <typename F>
+double measureFastest(F f) {
+    double fastest = measure(f);
+    for (int i = 1; i < repeats; i++) {
+        fastest = std::min(fastest, measure(f));
+    }
+    return fastest;
+}
+
+// Collects register state before every command, evenly distributed over whole logs
+std::map<uint32_t, Opcode> collectOpcodes(const std::vector<GteLog>& logs) {
+    std::map<uint32_t, Opcode> opcodes;
+    for (auto& log : logs) {
+        GTE gte;
+        for (auto& testCase : log.testCases) {
+            for (auto& input : testCase.input) {
+                gte.write(input.reg, input.data);
+            }
+
+            if (!testCase.runCmd) continue;
+
+            auto& opcode = opcodes[opcodeKey(testCase.cmd)];
+            if (opcode.name.empty()) {
+                opcode.name = opcodeName(testCase.cmd);
+            }
+
+            Sample sample;
+            sample.cmd = testCase.cmd;
+            saveState(gte, sample);
+            opcode.samples.push_back(sample);
+
+            gte::Command cmd = testCase.cmd;
+            gte.command(cmd);
+        }
+    }
+
+    for (auto& it : opcodes) {
+        auto& samples = it.second.samples;
+        if (samples.size() <= maxSamples) continue;
+
+        std::vector<Sample> picked;
+        for (size_t i = 0; i < maxSamples; i++) {
+            picked.push_back(samples[i * samples.size() / maxSamples]);
+        }
+        samples = std::move(picked);
+    }
+    return opcodes;
+}
+};  // namespace
+
+void runBenchmark(const std::vector<GteLog>& logs, int iterations, const std::string& jsonFile) {
+    size_t commands = 0;
+    uint32_t checksum = 0;  // Prevents compiler from optimizing reads away
+
+    double replayTime = measure([&] {
+        for (auto& log : logs) {
+            GTE gte;
+            for (int i = 0; i < iterations; i++) {
+                for (auto& testCase : log.testCases) {
+                    for (auto& input : testCase.input) {
+                        gte.write(input.reg, input.data);
+                    }
+
+                    if (testCase.runCmd) {
+                        gte::Command cmd = testCase.cmd;
+                        gte.command(cmd);
+                        commands++;
+                    }
+
+                    for (auto& expected : testCase.expectedOutput) {
+                        checksum += gte.read(expected.reg);
+                    }
+                }
+            }
+        }
+    });
+
+    printf("\n\nBenchmark:\n");
+    printf("Iterations: %d\n", iterations);
+    printf("Commands executed: %zu\n", commands);
+    printf("Time: %.3f s\n", replayTime);
+    printf("Operations per second: %.0f\n", commands / replayTime);
+
+    auto opcodes = collectOpcodes(logs);
+
+    // Restoring state is measured separately and subtracted from the command loop
+    printf("\n%-28s %8s %10s\n", "Opcode", "Samples", "ns/op");
+    for (auto& it : opcodes) {
+        auto& opcode = it.second;
+        GTE gte;
+
+        double restoreTime = measureFastest([&] {
+            for (int i = 0; i < iterations; i++) {
+                for (auto& sample : opcode.samples) {
+                    loadState(gte, sample);
+                    checksum += gte.read(63);
+                }
+            }
+        });
+
+        double commandTime = measureFastest([&] {
+            for (int i = 0; i < iterations; i++) {
+                for (auto& sample : opcode.samples) {
+                    loadState(gte, sample);
+                    gte::Command cmd = sample.cmd;
+                    gte.command(cmd);
+                    checksum += gte.read(63);
+                }
+            }
+        });
+
+        size_t ops = (size_t)iterations * opcode.samples.size();
+        opcode.nsPerOp = std::max(0.0, commandTime - restoreTime) * 1e9 / ops;
+        printf("%-28s %8zu %10.2f\n", opcode.name.c_str(), opcode.samples.size(), opcode.nsPerOp);
+    }
+    printf("\nChecksum: 0x%08x\n", checksum);
+
+    if (jsonFile.empty()) return;
+
+    std::string json = "{\n  \"logs\": [";
+    for (size_t i = 0; i < logs.size(); i++) {
+        json += fmt::format("{}\"{}\"", i > 0 ? ", " : "", escapeJson(logs[i].path));
+    }
+    json += "],\n";
+    json += fmt::format("  \"iterations\": {},\n", iterations);
+    json += fmt::format("  \"replay\": {{\"commands\": {}, \"seconds\": {:.6f}, \"opsPerSecond\": {:.0f}}},\n", commands, replayTime,
+                        commands / replayTime);
+    json += "  \"opcodes\": [";
+    bool first = true;
+    for (auto& it : opcodes) {
+        auto& opcode = it.second;
+        json += fmt::format("{}\n    {{\"name\": \"{}\", \"samples\": {}, \"nsPerOp\": {:.3f}}}", first ? "" : ",",
+                            escapeJson(opcode.name), opcode.samples.size(), opcode.nsPerOp);
+        first = false;
+    }
+    json += "\n  ]\n}\n";
+
+    if (!putFileContents(jsonFile, json)) {
+        printf("Unable to write %s\n", jsonFile.c_str());
+        return;
+    }
+    printf("Summary written to %s\n", jsonFile.c_str());
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "log_file.h"
+
+// Replays parsed logs (register writes and commands) without assertions, as fast as possible.
+// Then every opcode (MVMVA split by its variants) is executed in a tight loop from register
+// states cached right before it was issued in the logs and timed separately.
+// Summary is written to jsonFile (if not empty) for comparing builds.
+void runBenchmark(const std::vector<GteLog>& logs, int iterations, const std::string& jsonFile);
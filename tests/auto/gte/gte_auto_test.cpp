@@ -1,13 +1,19 @@
+#include <algorithm>
+#include <cstring>
+#include "benchmark.h"
 #include "cpu/gte/gte.h"
 #include "log_file.h"
 #include "utils/file.h"
 
 void printHelp() {
     printf(R"(
-usage: avocado_autotest logfile.log
-  --ignore-flag - ignore reg[63] differences
-  --show-input  - print input data on failed assertion
-  --help        - print help
+usage: avocado_autotest logfile.log [logfile2.log ...]
+  --ignore-flag  - ignore reg[63] differences
+  --show-input   - print input data on failed assertion
+  --benchmark    - replay logs as fast as possible and report operations per second and ns/op per opcode
+  --iterations=N - number of log replays in benchmark mode (default 100)
+  --json=FILE    - write benchmark summary to FILE
+  --help         - print help
 )");
 }
 
@@ -36,11 +42,14 @@ int main(int argc, char** argv) {
         return 0;
     }
 
-    std::string logfile;
+    std::vector<std::string> logfiles;
+    std::string jsonFile;
     bool showInput = false;
     bool ignoreFlag = false;
+    bool benchmark = false;
+    int iterations = 100;
 
-    for (int i = 0; i < argc; i++) {
+    for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--ignore-flag") == 0) {
             ignoreFlag = true;
             continue;
@@ -49,26 +58,48 @@ int main(int argc, char** argv) {
             showInput = true;
             continue;
         }
+        if (strcmp(argv[i], "--benchmark") == 0) {
+            benchmark = true;
+            continue;
+        }
+        if (strncmp(argv[i], "--iterations=", 13) == 0) {
+            iterations = std::max(1, atoi(argv[i] + 13));
+            continue;
+        }
+        if (strncmp(argv[i], "--json=", 7) == 0) {
+            jsonFile = argv[i] + 7;
+            continue;
+        }
         if (strcmp(argv[i], "--help") == 0) {
             printHelp();
             return 0;
         }
 
-        if (i == argc - 1) {
-            logfile = argv[i];
-        }
+        logfiles.push_back(argv[i]);
     }
 
-    if (!fileExists(logfile)) {
-        printf("File %s does not exist.\n", logfile.c_str());
-        return 1;
+    if (logfiles.empty()) {
+        printHelp();
+        return 0;
     }
 
-    printf("Using file %s\n", logfile.c_str());
-    auto testCases = parseTestCases(logfile);
-    printf("Test cases found: %zd\n", testCases.size());
+    std::vector<GteLog> logs;
+    for (auto& logfile : logfiles) {
+        if (!fileExists(logfile)) {
+            printf("File %s does not exist.\n", logfile.c_str());
+            return 1;
+        }
 
-    GTE gte;
+        printf("Using file %s\n", logfile.c_str());
+        auto testCases = parseTestCases(logfile);
+        printf("Test cases found: %zd\n", testCases.size());
+        logs.push_back({logfile, std::move(testCases)});
+    }
+
+    if (benchmark) {
+        runBenchmark(logs, iterations, jsonFile);
+        return 0;
+    }
 
     int testsFailed = 0;
     int testsSuccessful = 0;
@@ -77,46 +108,50 @@ int main(int argc, char** argv) {
 
     int testNumber = 1;
 
-    for (auto& testCase : testCases) {
-        bool testFailed = false;
+    // Every log starts from reset state
+    for (auto& log : logs) {
+        GTE gte;
+        for (auto& testCase : log.testCases) {
+            bool testFailed = false;
 
-        for (auto& input : testCase.input) {
-            gte.write(input.reg, input.data);
-        }
+            for (auto& input : testCase.input) {
+                gte.write(input.reg, input.data);
+            }
 
-        if (testCase.runCmd) {
-            gte.command(testCase.cmd);
-        }
+            if (testCase.runCmd) {
+                gte.command(testCase.cmd);
+            }
 
-        for (auto& expected : testCase.expectedOutput) {
-            auto data = gte.read(expected.reg);
+            for (auto& expected : testCase.expectedOutput) {
+                auto data = gte.read(expected.reg);
 
-            if (data == expected.data) {
-                assertionsSuccessful++;
-                continue;
-            }
+                if (data == expected.data) {
+                    assertionsSuccessful++;
+                    continue;
+                }
 
-            assertionsFailed++;
-            if (!testFailed) {
-                if (expected.reg == 63 && ignoreFlag) continue;
+                assertionsFailed++;
+                if (!testFailed) {
+                    if (expected.reg == 63 && ignoreFlag) continue;
 
-                testFailed = true;
-                printInfo(testCase, testNumber);
+                    testFailed = true;
+                    printInfo(testCase, testNumber);
+                }
+                printf("  r[%2d]:  0x%08x  -  0x%08x\n", expected.reg, data, expected.data);
             }
-            printf("  r[%2d]:  0x%08x  -  0x%08x\n", expected.reg, data, expected.data);
-        }
 
-        if (testFailed && showInput) {
-            printInput(testCase);
-        }
+            if (testFailed && showInput) {
+                printInput(testCase);
+            }
 
-        if (testFailed) {
-            testsFailed++;
-        } else {
-            testsSuccessful++;
-        }
+            if (testFailed) {
+                testsFailed++;
+            } else {
+                testsSuccessful++;
+            }
 
-        testNumber++;
+            testNumber++;
+        }
     }
     printf("\n\nStats:\n");
     printf("Tests total: %d\n", testsFailed + testsSuccessful);
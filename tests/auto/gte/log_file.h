@@ -26,4 +26,9 @@ struct GteTestCase {
     GteTestCase() : cmd(0), runCmd(false) {}
 };
 
+struct GteLog {
+    std::string path;
+    std::vector<GteTestCase> testCases;
+};
+
 std::vector<GteTestCase> parseTestCases(const std::string& file);
\ No newline at end of file
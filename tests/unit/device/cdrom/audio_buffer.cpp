@@ -0,0 +1,58 @@
+#include "device/cdrom/audio_buffer.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+using device::cdrom::AudioBuffer;
+
+namespace {
+std::vector<AudioBuffer::Sample> makeSamples(size_t count, int16_t start) {
+    std::vector<AudioBuffer::Sample> samples(count);
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = {(int16_t)(start + i), (int16_t)-(start + i)};
+    }
+    return samples;
+}
+};  // namespace
+
+TEST_CASE("AudioBuffer keeps sample order across wrap around", "[cdrom]") {
+    AudioBuffer buffer;
+    std::vector<AudioBuffer::Sample> out(AudioBuffer::CAPACITY);
+
+    auto first = makeSamples(AudioBuffer::CAPACITY - 100, 0);
+    REQUIRE(buffer.push(first.data(), first.size()) == first.size());
+    REQUIRE(buffer.pop(out.data(), first.size()) == first.size());
+
+    auto second = makeSamples(588, 1000);  // Crosses end of storage
+    REQUIRE(buffer.push(second.data(), second.size()) == second.size());
+    REQUIRE(buffer.size() == 588);
+    REQUIRE(buffer.pop(out.data(), 588) == 588);
+    for (size_t i = 0; i < 588; i++) {
+        REQUIRE(out[i] == second[i]);
+    }
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("AudioBuffer counts dropped samples and underruns", "[cdrom]") {
+    AudioBuffer buffer;
+    std::vector<AudioBuffer::Sample> out(64);
+
+    auto samples = makeSamples(AudioBuffer::CAPACITY + 10, 0);
+    REQUIRE(buffer.push(samples.data(), samples.size()) == AudioBuffer::CAPACITY);
+    REQUIRE(buffer.getOverruns() == 10);
+    REQUIRE(buffer.getPeak() == AudioBuffer::CAPACITY);
+
+    buffer.clear();
+    REQUIRE(buffer.pop(out.data(), 1) == 0);
+    REQUIRE(buffer.getUnderruns() == 0);  // Not playing yet
+
+    buffer.push(samples.data(), 3);
+    REQUIRE(buffer.pop(out.data(), 2) == 2);
+    REQUIRE(buffer.pop(out.data(), 2) == 1);
+    REQUIRE(buffer.getUnderruns() == 1);
+    REQUIRE(buffer.pop(out.data(), 2) == 0);
+    REQUIRE(buffer.getUnderruns() == 1);  // Counted once per gap
+
+    buffer.resetStats();
+    REQUIRE(buffer.getOverruns() == 0);
+    REQUIRE(buffer.getPeak() == 0);
+}
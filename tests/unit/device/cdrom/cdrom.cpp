@@ -0,0 +1,152 @@
+#include "device/cdrom/cdrom.h"
+#include <catch2/catch.hpp>
+#include <vector>
+#include "config.h"
+#include "disc/test_disc.h"
+
+using device::cdrom::CDROM;
+
+namespace {
+std::vector<uint8_t> makeSector() {
+    std::vector<uint8_t> sector(2352);
+    for (size_t i = 0; i < sector.size(); i++) {
+        sector[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    return sector;
+}
+
+void setSectorSize(CDROM& cdrom, bool wholeSector) {
+    cdrom.write(0, 0);                       // Index 0
+    cdrom.write(2, wholeSector ? 0x20 : 0);  // Parameter
+    cdrom.write(1, 0x0e);                    // Setmode
+}
+
+void loadBuffer(CDROM& cdrom) {
+    cdrom.dataBuffer = makeSector();
+    cdrom.dataBufferPointer = 0;
+}
+
+// Single data track, every sector is Mode2 Form1 with its lba in the header
+std::unique_ptr<disc::Disc> makeDisc() {
+    auto disc = std::make_unique<disc::test::TestDisc>(std::vector<disc::test::TestDisc::TrackInfo>{{1000, disc::TrackType::DATA}}, 0);
+    disc->fill = [](int lba, uint8_t* sector) {
+        std::fill(sector + 1, sector + 11, 0xff);  // Sync
+        sector[12] = (uint8_t)lba;
+        sector[15] = 2;  // Mode
+    };
+    return disc;
+}
+
+const int SECTOR_CYCLES = 33868800 / 75;
+
+// Runs drive until interrupt shows up, returns its number (0 if nothing happened)
+int waitInterrupt(CDROM& cdrom, int cycles) {
+    cdrom.write(0, 1);
+    for (int i = 0; i < cycles; i += 100) {
+        if (int irq = cdrom.read(3) & 7) return irq;
+        cdrom.step(100);
+    }
+    return cdrom.read(3) & 7;
+}
+
+void ackInterrupt(CDROM& cdrom) {
+    cdrom.write(0, 1);
+    cdrom.write(3, 0x1f);
+}
+
+// Sets config option for the duration of a test, old value is restored even if test fails
+template <typename T>
+class ConfigOverride {
+    T& option;
+    T saved;
+
+   public:
+    ConfigOverride(T& target, T value) : option(target), saved(target) { option = value; }
+    ~ConfigOverride() { option = saved; }
+    ConfigOverride(const ConfigOverride&) = delete;
+    ConfigOverride& operator=(const ConfigOverride&) = delete;
+};
+
+void requestData(CDROM& cdrom) {
+    cdrom.write(0, 0);
+    cdrom.write(3, 0x80);
+}
+};  // namespace
+
+TEST_CASE("CDROM readBlock returns same data as readByte", "[cdrom]") {
+    bool wholeSector = GENERATE(false, true);
+    size_t dataSize = wholeSector ? 0x924 : 0x800;
+
+    CDROM bulk(nullptr), bytes(nullptr);
+    setSectorSize(bulk, wholeSector);
+    setSectorSize(bytes, wholeSector);
+    loadBuffer(bulk);
+    loadBuffer(bytes);
+
+    // Split in uneven parts, last one reads past the end of data
+    std::vector<size_t> parts = {4, 0x200, dataSize - 0x204 - 8, 8 + 16};
+    for (size_t part : parts) {
+        std::vector<uint8_t> expected(part), actual(part);
+        for (auto& b : expected) b = bytes.readByte();
+        bulk.readBlock(actual.data(), part);
+
+        REQUIRE(actual == expected);
+        REQUIRE(bulk.dataBufferPointer == bytes.dataBufferPointer);
+        REQUIRE(bulk.isBufferEmpty() == bytes.isBufferEmpty());
+        REQUIRE(bulk.read(0) == bytes.read(0));  // Status, data fifo empty bit
+    }
+    REQUIRE(bulk.isBufferEmpty());
+}
+
+TEST_CASE("CDROM readBlock on empty buffer returns zeroes", "[cdrom]") {
+    CDROM cdrom(nullptr);
+
+    std::vector<uint8_t> data(4, 0xff);
+    cdrom.readBlock(data.data(), data.size());
+
+    REQUIRE(data == std::vector<uint8_t>(4, 0));
+}
+
+TEST_CASE("CDROM queued interrupts keep their own delay", "[cdrom]") {
+    CDROM cdrom(nullptr);
+
+    cdrom.write(0, 0);
+    cdrom.write(1, 0x0a);  // Init, INT3 followed by delayed INT2
+    REQUIRE(waitInterrupt(cdrom, 100000) == 3);
+
+    cdrom.ackMoreData();  // INT1 without delay queued behind INT2
+    ackInterrupt(cdrom);
+
+    // INT2 delay counts from acknowledge of INT3 (0x4a00 cycles)
+    REQUIRE(waitInterrupt(cdrom, 0x4000) == 0);
+    REQUIRE(waitInterrupt(cdrom, 0x1000) == 2);
+    ackInterrupt(cdrom);
+
+    REQUIRE(waitInterrupt(cdrom, 100) == 1);
+}
+
+TEST_CASE("CDROM instant disc waits until sector is taken", "[cdrom]") {
+    ConfigOverride<bool> instantDisc(config.options.emulator.instantDisc, true);
+
+    CDROM cdrom(nullptr);
+    cdrom.disc = makeDisc();
+
+    cdrom.write(0, 0);
+    cdrom.write(1, 0x06);  // ReadN from 00:00:00
+    REQUIRE(waitInterrupt(cdrom, 100000) == 3);
+    ackInterrupt(cdrom);
+
+    for (int lba = 0; lba < 4; lba++) {
+        // First sector takes full sector period, following ones come right after previous was taken
+        REQUIRE(waitInterrupt(cdrom, lba == 0 ? SECTOR_CYCLES : 100) == 1);
+        ackInterrupt(cdrom);
+
+        // Acknowledged but not requested yet, sector must not be replaced
+        REQUIRE(waitInterrupt(cdrom, 1000) == 0);
+
+        requestData(cdrom);
+        REQUIRE(cdrom.dataBuffer.at(12) == lba);
+        cdrom.write(0, 0);
+        cdrom.write(3, 0);  // Clear data fifo
+    }
+}
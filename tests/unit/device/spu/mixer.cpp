@@ -0,0 +1,112 @@
+#include "device/spu/mixer.h"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <random>
+
+namespace spu {
+
+namespace {
+void randomize(Mixer& mixer, std::mt19937& rng) {
+    std::uniform_int_distribution<int32_t> int16(INT16_MIN, INT16_MAX);
+    std::uniform_int_distribution<int32_t> volume(INT16_MIN, INT16_MAX);
+    std::uniform_int_distribution<int32_t> mask(-1, 0);
+
+    for (int i = 0; i < Mixer::LANES; i++) {
+        for (int j = 0; j < 4; j++) {
+            mixer.samples[j][i] = int16(rng);
+            mixer.gauss[j][i] = int16(rng);
+        }
+        mixer.noise[i] = mask(rng);
+        mixer.adsrVolume[i] = volume(rng);
+        mixer.volumeLeft[i] = int16(rng);
+        mixer.volumeRight[i] = int16(rng);
+        mixer.reverb[i] = mask(rng);
+    }
+}
+
+void fillVoices(Mixer& mixer) {
+    for (int i = 0; i < Mixer::LANES; i++) {
+        for (int j = 0; j < 4; j++) {
+            mixer.samples[j][i] = (i * 1031 + j * 4093) % 0x8000 - 0x4000;
+            mixer.gauss[j][i] = 0x1000 * (j + 1);
+        }
+        mixer.adsrVolume[i] = 0x7fff;
+        mixer.volumeLeft[i] = 0x0800;
+        mixer.volumeRight[i] = 0x0800;
+        mixer.reverb[i] = i % 2 ? -1 : 0;
+    }
+}
+};  // namespace
+
+TEST_CASE("Mixer SIMD path matches scalar path", "[spu_mixer]") {
+    std::mt19937 rng(0x5b0);
+    Mixer simd, scalar;
+
+    for (int n = 0; n < 1000; n++) {
+        randomize(simd, rng);
+        scalar = simd;
+
+        int16_t noiseLevel = (int16_t)rng();
+        simd.process(noiseLevel);
+        scalar.processScalar(noiseLevel);
+
+        REQUIRE(simd.output == scalar.output);
+        REQUIRE(simd.left == scalar.left);
+        REQUIRE(simd.right == scalar.right);
+        REQUIRE(simd.reverbLeft == scalar.reverbLeft);
+        REQUIRE(simd.reverbRight == scalar.reverbRight);
+    }
+}
+
+TEST_CASE("Mixer wraps voice sample after ADSR to int16_t", "[spu_mixer]") {
+    Mixer mixer;
+    mixer.noise.fill(-1);
+    mixer.adsrVolume.fill(INT16_MIN);
+    mixer.volumeLeft.fill(0x7fff);
+
+    // -0x8000 * -0x8000 >> 15 is 0x8000, doesn't fit in int16_t
+    mixer.process(INT16_MIN);
+    REQUIRE(mixer.output[0] == INT16_MIN);
+    REQUIRE(mixer.left[0] == -0x7fff);
+
+    mixer.processScalar(INT16_MIN);
+    REQUIRE(mixer.output[0] == INT16_MIN);
+    REQUIRE(mixer.left[0] == -0x7fff);
+}
+
+TEST_CASE("Mixer saturates after every voice", "[spu_mixer]") {
+    Mixer mixer;
+    mixer.left.fill(0);
+    mixer.left[0] = 0x7000;
+    mixer.left[1] = 0x7000;
+    mixer.left[2] = -0x1000;
+
+    Sample left, right, reverbLeft, reverbRight;
+    mixer.sum(left, right, reverbLeft, reverbRight);
+
+    REQUIRE(left == 0x6fff);
+}
+
+// Run with: avocado_test [.benchmark]
+TEST_CASE("Mixer benchmark - 24 voices, 1 second", "[.benchmark][spu_mixer]") {
+    const int samplesPerSecond = 44100;
+    Mixer mixer;
+    fillVoices(mixer);
+
+    int32_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samplesPerSecond; i++) {
+        Sample left, right, reverbLeft, reverbRight;
+        mixer.process((int16_t)i);
+        mixer.sum(left, right, reverbLeft, reverbRight);
+        checksum += left + right + reverbLeft + reverbRight;
+        mixer.samples[3][i % Mixer::LANES] = (int16_t)checksum;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    printf("Mixed %d samples of %d voices in %.3f ms (checksum 0x%08x)\n", samplesPerSecond, Mixer::LANES, ms, checksum);
+    SUCCEED();
+}
+
+}  // namespace spu
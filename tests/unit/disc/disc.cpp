@@ -0,0 +1,147 @@
+#include "disc/disc.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "disc/test_disc.h"
+#include "utils/bcd.h"
+
+using namespace disc;
+using disc::test::TempFile;
+using disc::test::TestDisc;
+
+namespace {
+// Data track followed by an audio track, both start after 2 second pregap
+const int DATA_START = 150;
+const int DATA_FRAMES = 20000;
+const int AUDIO_START = DATA_START + DATA_FRAMES;
+const int AUDIO_FRAMES = 3000;
+
+TestDisc makeDisc() { return TestDisc({{DATA_FRAMES, TrackType::DATA}, {AUDIO_FRAMES, TrackType::AUDIO}}, DATA_START); }
+
+// LibCrypt sectors come in pairs 5 frames apart,
+// each one has a bit flipped in relative and absolute MSF and broken CRC
+const std::array<Position, 8> LIBCRYPT_SECTORS = {{
+    {3, 8, 5},   {3, 8, 10},   //
+    {3, 17, 41}, {3, 17, 46},  //
+    {3, 40, 63}, {3, 40, 68},  //
+    {4, 1, 7},   {4, 1, 12},   //
+}};
+
+SubchannelQ libcryptQ(Position pos) {
+    auto posInTrack = pos - Position::fromLba(DATA_START);
+    auto q = SubchannelQ::generateForPosition(0, pos, posInTrack, false);
+    q.data[3] ^= 0x01;  // S - track
+    q.data[7] ^= 0x01;  // S - disc
+    return q;
+}
+
+std::vector<uint8_t> makeSbi() {
+    std::vector<uint8_t> sbi = {'S', 'B', 'I', 0};
+    // Written out of order, loader sorts entries
+    for (int i = LIBCRYPT_SECTORS.size() - 1; i >= 0; i--) {
+        auto pos = LIBCRYPT_SECTORS[i];
+        auto q = libcryptQ(pos);
+
+        sbi.push_back(bcd::toBcd(pos.mm));
+        sbi.push_back(bcd::toBcd(pos.ss));
+        sbi.push_back(bcd::toBcd(pos.ff));
+        sbi.push_back(1);  // Whole Q (without CRC) follows
+        sbi.push_back(q.control.reg);
+        for (auto b : q.data) sbi.push_back(b);
+    }
+    return sbi;
+}
+
+// Same entries in .sbi file layout: "SBI\0", then per entry BCD absolute MSF, type 1 and 10 bytes of Q without CRC.
+// Written by hand, expected Q is not derived from the generator used by the loader.
+const uint8_t LIBCRYPT_SBI[] = {
+    'S',  'B',  'I',  0x00,
+    0x03, 0x08, 0x05, 0x01, 0x41, 0x01, 0x01, 0x03, 0x07, 0x05, 0x00, 0x03, 0x09, 0x05,  // 03:08:05
+    0x03, 0x08, 0x10, 0x01, 0x41, 0x01, 0x01, 0x03, 0x07, 0x10, 0x00, 0x03, 0x09, 0x10,  // 03:08:10
+    0x03, 0x17, 0x41, 0x01, 0x41, 0x01, 0x01, 0x03, 0x14, 0x41, 0x00, 0x03, 0x16, 0x41,  // 03:17:41
+    0x03, 0x17, 0x46, 0x01, 0x41, 0x01, 0x01, 0x03, 0x14, 0x46, 0x00, 0x03, 0x16, 0x46,  // 03:17:46
+    0x03, 0x40, 0x63, 0x01, 0x41, 0x01, 0x01, 0x03, 0x39, 0x63, 0x00, 0x03, 0x41, 0x63,  // 03:40:63
+    0x03, 0x40, 0x68, 0x01, 0x41, 0x01, 0x01, 0x03, 0x39, 0x68, 0x00, 0x03, 0x41, 0x68,  // 03:40:68
+    0x04, 0x01, 0x07, 0x01, 0x41, 0x01, 0x01, 0x03, 0x58, 0x07, 0x00, 0x04, 0x00, 0x07,  // 04:01:07
+    0x04, 0x01, 0x12, 0x01, 0x41, 0x01, 0x01, 0x03, 0x58, 0x12, 0x00, 0x04, 0x00, 0x12,  // 04:01:12
+};
+
+bool sameQ(SubchannelQ a, SubchannelQ b) {
+    return a.control.reg == b.control.reg && std::equal(a.data, a.data + 9, b.data) && a.crc16 == b.crc16;
+}
+};  // namespace
+
+TEST_CASE("Disc returns Q from .sbi for LibCrypt sectors", "[disc]") {
+    TempFile sbi("libcrypt_test.sbi");
+    REQUIRE(sbi.write(makeSbi()));
+
+    // .sbi is looked up next to the image
+    auto disc = makeDisc();
+    disc.file = sbi.getPath().substr(0, sbi.getPath().size() - 4) + ".cue";
+    REQUIRE(disc.loadSubchannel(disc.file));
+
+    for (auto pos : LIBCRYPT_SECTORS) {
+        auto q = disc.getSubQ(pos);
+        auto expected = libcryptQ(pos);
+
+        REQUIRE(q.control.reg == expected.control.reg);
+        REQUIRE(std::equal(q.data, q.data + 9, expected.data));
+        REQUIRE_FALSE(q.validCrc());  // Checked by LibCrypt
+    }
+
+    // Neighbours are not modified
+    for (auto pos : LIBCRYPT_SECTORS) {
+        for (int delta : {-1, 1}) {
+            auto neighbour = Position::fromLba(pos.toLba() + delta);
+            REQUIRE(disc.getSubQ(neighbour).validCrc());
+        }
+    }
+}
+
+TEST_CASE("Disc loads Q of LibCrypt sectors from .sbi file as is", "[disc]") {
+    TempFile sbi("libcrypt_raw.sbi");
+    REQUIRE(sbi.write(std::vector<uint8_t>(std::begin(LIBCRYPT_SBI), std::end(LIBCRYPT_SBI))));
+
+    auto disc = makeDisc();
+    disc.file = sbi.getPath().substr(0, sbi.getPath().size() - 4) + ".cue";
+    REQUIRE(disc.loadSubchannel(disc.file));
+
+    const size_t ENTRY_SIZE = 14;
+    for (size_t p = 4; p + ENTRY_SIZE <= sizeof(LIBCRYPT_SBI); p += ENTRY_SIZE) {
+        const uint8_t* entry = &LIBCRYPT_SBI[p];
+        auto pos = Position(bcd::toBinary(entry[0]), bcd::toBinary(entry[1]), bcd::toBinary(entry[2]));
+        INFO(pos.toString());
+
+        auto q = disc.getSubQ(pos);
+        REQUIRE(q.control.reg == entry[4]);
+        REQUIRE(std::equal(q.data, q.data + 9, entry + 5));
+        REQUIRE_FALSE(q.validCrc());
+
+        // Only seconds of relative and absolute MSF differ from regular Q
+        auto regular = SubchannelQ::generateForPosition(0, pos, pos - Position::fromLba(DATA_START), false);
+        for (int i = 0; i < 9; i++) {
+            REQUIRE((q.data[i] != regular.data[i]) == (i == 3 || i == 7));
+        }
+    }
+}
+
+TEST_CASE("Disc generates Q from position and track", "[disc]") {
+    auto disc = makeDisc();
+
+    for (int lba : {DATA_START, 1000, AUDIO_START - 1, AUDIO_START, AUDIO_START + 1234}) {
+        auto pos = Position::fromLba(lba);
+        int track = disc.getTrackByPosition(pos);
+        bool audio = track == 1;
+        auto expected = SubchannelQ::generateForPosition(track, pos, pos - disc.getTrackStart(track), audio);
+
+        auto q = disc.getSubQ(pos);
+        REQUIRE(sameQ(q, expected));
+        REQUIRE(q.validCrc());
+        REQUIRE(q.control.data == !audio);
+        REQUIRE(q.data[0] == bcd::toBcd(track + 1));
+    }
+
+    // Track type is read once per track
+    REQUIRE(disc.reads == 2);
+}
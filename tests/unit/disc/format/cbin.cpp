@@ -0,0 +1,108 @@
+#include "disc/format/cbin.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include "disc/format/ecm_sector.h"
+#include "disc/test_disc.h"
+
+using namespace disc;
+using namespace disc::format;
+using disc::test::TempFile;
+
+namespace {
+const int PREGAP = 150;
+const int DATA_FRAMES = 100;
+const int AUDIO_FRAMES = 37;
+
+// Rebuilds sector filled with pattern as Mode1 or Mode2 sector with valid EDC/ECC
+void buildDataSector(int lba, uint8_t* sector) {
+    auto mode = (ecm::Type)(1 + lba % 3);
+    uint8_t input[4 + ecm::inputSize(ecm::Type::Mode2Form2)];
+    std::copy_n(sector, sizeof(input), input);
+
+    if (mode == ecm::Type::Mode1) {
+        ecm::decodeSector(mode, input, sector);
+        if (lba % 4 == 0) sector[0x900] ^= 1;  // Broken ECC is kept as is
+        return;
+    }
+
+    const uint8_t sync[12] = {0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00};
+    std::copy_n(sync, 12, sector);
+    sector[0x0f] = 2;
+    input[2] = mode == ecm::Type::Mode2Form2 ? 0x20 : 0x00;  // Submode form bit
+    ecm::decodeSector(mode, input, sector + 0x10);
+}
+
+// Data track and audio track after 2 second pregap, track queries behave like Chd:
+// start of the last track is reported as 00:02:00 and pregap reads return garbage.
+// Data track mixes Mode1, Mode2 and sectors with broken ECC.
+struct ChdLikeDisc : public test::TestDisc {
+    ChdLikeDisc() : TestDisc({{DATA_FRAMES, TrackType::DATA}, {AUDIO_FRAMES, TrackType::AUDIO}}, PREGAP) {
+        fill = [](int lba, uint8_t* sector) {
+            for (size_t i = 0; i < Track::SECTOR_SIZE; i++) {
+                sector[i] = (uint8_t)(lba * 13 + i);
+            }
+            if (lba >= PREGAP && lba < PREGAP + DATA_FRAMES) {
+                buildDataSector(lba, sector);
+            }
+        };
+    }
+
+    int getTrackByPosition(Position pos) const override { return std::max(TestDisc::getTrackByPosition(pos), 0); }
+    Position getTrackStart(int track) const override {
+        if (track == (int)tracks.size()) return Position(0, 2, 0);
+        return TestDisc::getTrackStart(std::max(track - 1, 0));
+    }
+};
+};  // namespace
+
+TEST_CASE("Cbin round trip keeps sectors, track types and Q", "[cbin]") {
+    TempFile file("cbin_test.cbin");
+    ChdLikeDisc source;
+    REQUIRE(Cbin::write(source, file.getPath(), 1));
+
+    auto cbin = Cbin::open(file.getPath());
+    REQUIRE(cbin != nullptr);
+
+    REQUIRE(cbin->getTrackCount() == 2);
+    REQUIRE(cbin->getTrackStart(1).toLba() == PREGAP);
+    REQUIRE(cbin->getTrackStart(2).toLba() == PREGAP + DATA_FRAMES);
+    REQUIRE(cbin->getDiskSize() == source.getDiskSize());
+
+    for (int lba = PREGAP; lba < source.getDiskSize().toLba(); lba++) {
+        auto pos = Position::fromLba(lba);
+        INFO("lba " << lba);
+
+        auto expected = source.read(pos);
+        std::array<uint8_t, Track::SECTOR_SIZE> data;
+        std::copy(expected.begin(), expected.end(), data.begin());
+
+        auto sector = cbin->read(pos);
+        REQUIRE(sector.type == expected.type);
+        REQUIRE(std::equal(data.begin(), data.end(), sector.begin(), sector.end()));
+
+        auto qa = source.getSubQ(pos);
+        auto qb = cbin->getSubQ(pos);
+        REQUIRE(qa.control.reg == qb.control.reg);
+        REQUIRE(memcmp(qa.data, qb.data, sizeof(qa.data)) == 0);
+        REQUIRE(qa.crc16 == qb.crc16);
+    }
+}
+
+TEST_CASE("Cbin doesn't store pregap outside of tracks", "[cbin]") {
+    TempFile file("cbin_test.cbin");
+    ChdLikeDisc source;
+    REQUIRE(Cbin::write(source, file.getPath(), 1));
+
+    auto cbin = Cbin::open(file.getPath());
+    REQUIRE(cbin != nullptr);
+
+    auto pos = Position(0, 0, 0);
+    REQUIRE(cbin->getTrackByPosition(pos) == -1);
+
+    auto sector = cbin->read(pos);
+    REQUIRE(sector.type == TrackType::INVALID);
+    REQUIRE(std::all_of(sector.begin(), sector.end(), [](uint8_t b) { return b == 0; }));
+    REQUIRE(cbin->getSubQ(pos).validCrc());
+}
@@ -0,0 +1,52 @@
+#include "disc/format/chd_track_table.h"
+#include <catch2/catch.hpp>
+
+using disc::Position;
+using disc::format::ChdTrackTable;
+
+namespace {
+// Data track followed by two audio tracks, stored from 00:02:00
+ChdTrackTable makeTable() {
+    ChdTrackTable table;
+    table.build({1000, 300, 50});
+    return table;
+}
+
+const int START = 150;
+};  // namespace
+
+TEST_CASE("ChdTrackTable matches first and last frame of every track", "[chd]") {
+    auto table = makeTable();
+    REQUIRE(table.count() == 3);
+
+    REQUIRE(table.trackByPosition(Position::fromLba(START)) == 0);
+    REQUIRE(table.trackByPosition(Position::fromLba(START + 999)) == 0);
+    REQUIRE(table.trackByPosition(Position::fromLba(START + 1000)) == 1);
+    REQUIRE(table.trackByPosition(Position::fromLba(START + 1299)) == 1);
+    REQUIRE(table.trackByPosition(Position::fromLba(START + 1300)) == 2);
+    REQUIRE(table.trackByPosition(Position::fromLba(START + 1349)) == 2);
+}
+
+TEST_CASE("ChdTrackTable reports positions outside of tracks as track 0", "[chd]") {
+    auto table = makeTable();
+
+    REQUIRE(table.trackByPosition(Position(0, 0, 0)) == 0);
+    REQUIRE(table.trackByPosition(Position::fromLba(START - 1)) == 0);
+    REQUIRE(table.trackByPosition(Position::fromLba(START + 1350)) == 0);
+    REQUIRE(table.end() == Position::fromLba(START + 1350));
+}
+
+TEST_CASE("ChdTrackTable returns start of every track including the last one", "[chd]") {
+    auto table = makeTable();
+
+    REQUIRE(table.trackStart(0) == Position::fromLba(START));
+    REQUIRE(table.trackStart(1) == Position::fromLba(START));
+    REQUIRE(table.trackStart(2) == Position::fromLba(START + 1000));
+    REQUIRE(table.trackStart(3) == Position::fromLba(START + 1300));
+    REQUIRE(table.trackStart(4) == Position(0, 2, 0));
+
+    ChdTrackTable empty;
+    REQUIRE(empty.count() == 0);
+    REQUIRE(empty.trackStart(1) == Position(0, 2, 0));
+    REQUIRE(empty.end() == Position(0, 2, 0));
+}
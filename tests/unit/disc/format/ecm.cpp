@@ -0,0 +1,172 @@
+#include "disc/format/ecm.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <random>
+#include <vector>
+#include "disc/format/ecm_parser.h"
+#include "disc/test_disc.h"
+
+using namespace disc;
+using namespace disc::format;
+using disc::test::TempFile;
+
+namespace {
+
+void writeRecord(std::vector<uint8_t>& ecm, int type, uint32_t count) {
+    uint32_t c = count - 1;
+    uint8_t byte = type | ((c & 0x1f) << 2);
+    c >>= 5;
+    ecm.push_back(byte | (c ? 0x80 : 0));
+    while (c) {
+        byte = c & 0x7f;
+        c >>= 7;
+        ecm.push_back(byte | (c ? 0x80 : 0));
+    }
+}
+
+// file must outlive parsed Ecm which keeps the file open
+std::unique_ptr<Ecm> parse(const TempFile& file, const std::vector<uint8_t>& ecm) {
+    if (!file.write(ecm)) return {};
+    return EcmParser().parse(file.getPath().c_str());
+}
+
+std::vector<uint8_t> header() { return {'E', 'C', 'M', 0}; }
+
+void writeEnd(std::vector<uint8_t>& ecm) {
+    for (uint8_t b : {0xfc, 0xff, 0xff, 0xff, 0x7f}) ecm.push_back(b);
+}
+
+// Bytewise P/Q parity, one GF(2^8) table lookup per byte
+void referenceECCBlock(const uint8_t* src, uint32_t majorCount, uint32_t minorCount, uint32_t majorMult, uint32_t minorInc,
+                       uint8_t* dst) {
+    std::array<uint8_t, 256> eccf, eccb;
+    for (int i = 0; i < 256; i++) {
+        eccf[i] = (i << 1) ^ (i & 0x80 ? 0x11d : 0);
+        eccb[i ^ eccf[i]] = i;
+    }
+
+    uint32_t size = majorCount * minorCount;
+    for (uint32_t major = 0; major < majorCount; major++) {
+        uint32_t index = (major >> 1) * majorMult + (major & 1);
+        uint8_t a = 0, b = 0;
+        for (uint32_t minor = 0; minor < minorCount; minor++) {
+            uint8_t temp = src[index];
+            index += minorInc;
+            if (index >= size) index -= size;
+            a = eccf[a ^ temp];
+            b ^= temp;
+        }
+        a = eccb[eccf[a] ^ b];
+        dst[major] = a;
+        dst[major + majorCount] = a ^ b;
+    }
+}
+
+void referenceECC(uint8_t* frame) {
+    referenceECCBlock(frame + 0xc, 86, 24, 2, 86, frame + 0x81c);   // P
+    referenceECCBlock(frame + 0xc, 52, 43, 86, 88, frame + 0x8c8);  // Q, covers P parity
+}
+};  // namespace
+
+TEST_CASE("Ecm reconstructs sectors across record boundaries", "[ecm]") {
+    auto file = header();
+
+    writeRecord(file, 0, 100);  // Raw bytes, sectors are not aligned to records
+    for (int i = 0; i < 100; i++) file.push_back(i);
+
+    writeRecord(file, 1, 1);  // Mode1: address followed by 2048 bytes of data
+    file.insert(file.end(), {0x00, 0x02, 0x00});
+    for (int i = 0; i < 0x800; i++) file.push_back(i * 7);
+
+    writeRecord(file, 3, 1);  // Mode2Form2: subheader followed by 2324 bytes of data
+    file.insert(file.end(), {0x01, 0x02, 0x20, 0x00});
+    for (int i = 0; i < 0x914; i++) file.push_back(i * 3);
+
+    writeEnd(file);
+
+    TempFile testFile("ecm_test.ecm");
+    auto ecm = parse(testFile, file);
+    REQUIRE(ecm != nullptr);
+    REQUIRE(ecm->getDiskSize().toLba() == 2);
+
+    std::vector<uint8_t> image(100 + 2352 + 2336);
+    ecm->decode(0, image.data(), image.size());
+
+    for (int i = 0; i < 100; i++) REQUIRE(image[i] == i);
+
+    const uint8_t* mode1 = &image[100];
+    REQUIRE(mode1[0] == 0x00);
+    REQUIRE(mode1[1] == 0xff);
+    REQUIRE(mode1[11] == 0x00);
+    REQUIRE(mode1[0xd] == 0x02);
+    REQUIRE(mode1[0xf] == 0x01);
+    REQUIRE(mode1[0x10 + 5] == (uint8_t)(5 * 7));
+
+    uint32_t edc = ecm::calculateEDC(mode1, 0x810);
+    REQUIRE(mode1[0x810] == (edc & 0xff));
+    REQUIRE(mode1[0x813] == (edc >> 24));
+    for (int i = 0x814; i < 0x81c; i++) REQUIRE(mode1[i] == 0);
+
+    const uint8_t* form2 = &image[100 + 2352];  // Stored without sync and header
+    REQUIRE(form2[0] == 0x01);
+    REQUIRE(form2[4] == 0x01);  // Subheader is repeated
+    REQUIRE(form2[2] == 0x20);
+    edc = ecm::calculateEDC(form2, 0x91c);
+    REQUIRE(form2[0x91c] == (edc & 0xff));
+
+    SECTION("read returns decoded sectors") {
+        auto sector = ecm->read(Position(0, 2, 1));
+        REQUIRE(sector.size == 2352);
+        REQUIRE(std::equal(sector.begin(), sector.end(), image.begin() + 2352));
+
+        REQUIRE(ecm->read(Position(0, 2, 2)).type == TrackType::INVALID);
+    }
+}
+
+TEST_CASE("Ecm parser rejects truncated records", "[ecm]") {
+    auto file = header();
+    writeRecord(file, 2, 2);
+    file.resize(file.size() + 0x804);  // Only one of two sectors is present
+    writeEnd(file);
+
+    TempFile testFile("ecm_test.ecm");
+    REQUIRE(parse(testFile, file) == nullptr);
+}
+
+TEST_CASE("Ecm EDC matches bytewise CRC for any length and alignment", "[ecm]") {
+    auto reference = [](const uint8_t* data, size_t size) {
+        uint32_t edc = 0;
+        for (size_t i = 0; i < size; i++) {
+            edc ^= data[i];
+            for (int j = 0; j < 8; j++) edc = (edc >> 1) ^ (edc & 1 ? 0xD8018001 : 0);
+        }
+        return edc;
+    };
+
+    std::vector<uint8_t> data(64);
+    for (size_t i = 0; i < data.size(); i++) data[i] = i * 37 + 11;
+
+    for (size_t start = 0; start < 8; start++) {
+        for (size_t size = 0; start + size <= data.size(); size++) {
+            REQUIRE(ecm::calculateEDC(&data[start], size) == reference(&data[start], size));
+        }
+    }
+}
+
+TEST_CASE("Ecm ECC matches bytewise P and Q parity", "[ecm]") {
+    std::mt19937 rng(0xecc);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    for (int n = 0; n < 200; n++) {
+        std::array<uint8_t, 2352> frame;
+        for (auto& b : frame) b = byte(rng);
+        if (n == 0) frame.fill(0);
+        if (n == 1) frame.fill(0xff);
+
+        auto expected = frame;
+        referenceECC(expected.data());
+        ecm::calculateECC(frame.data());
+
+        REQUIRE(frame == expected);
+    }
+}
@@ -0,0 +1,67 @@
+#include "disc/format/hunk_cache.h"
+#include <catch2/catch.hpp>
+
+using disc::format::HunkCache;
+
+TEST_CASE("HunkCache evicts least recently used hunk", "[chd]") {
+    HunkCache cache;
+    cache.resize(3, 16);
+
+    for (size_t id : {0, 1, 2}) {
+        cache.allocate(id)->ready = true;
+    }
+    REQUIRE(cache.find(0) != nullptr);
+    cache.touch(cache.find(0));
+
+    cache.allocate(3)->ready = true;  // 1 is the oldest
+    REQUIRE(cache.find(1) == nullptr);
+    REQUIRE(cache.find(0) != nullptr);
+    REQUIRE(cache.find(2) != nullptr);
+
+    cache.allocate(4)->ready = true;  // then 2
+    REQUIRE(cache.find(2) == nullptr);
+    REQUIRE(cache.find(0) != nullptr);
+    REQUIRE(cache.find(3) != nullptr);
+}
+
+TEST_CASE("HunkCache never evicts pending hunks", "[chd]") {
+    HunkCache cache;
+    cache.resize(3, 16);
+
+    cache.allocate(0);  // Pending
+    cache.allocate(1)->ready = true;
+    cache.allocate(2)->ready = true;
+
+    cache.allocate(3);
+    REQUIRE(cache.find(0) != nullptr);
+    REQUIRE(cache.find(1) == nullptr);
+}
+
+TEST_CASE("HunkCache keeps prefetched hunks until they are read", "[chd]") {
+    // Same access pattern as Chd::read during sequential reading
+    const int SLOTS = 16;
+    const int PREFETCH = 2;
+
+    HunkCache cache;
+    cache.resize(SLOTS, 16);
+
+    int misses = 0;
+    for (size_t id = 0; id < 1000; id++) {
+        auto hunk = cache.find(id);
+        if (hunk == nullptr) {
+            misses++;
+            hunk = cache.allocate(id);
+        }
+        hunk->ready = true;
+        cache.touch(hunk);
+
+        for (size_t next = id + 1; next <= id + PREFETCH; next++) {
+            if (cache.find(next) == nullptr) {
+                cache.allocate(next)->ready = true;  // Fast workers, done before next read
+            }
+        }
+    }
+
+    // Only the first hunk wasn't prefetched
+    REQUIRE(misses == 1);
+}
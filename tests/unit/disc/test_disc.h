@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+#include "disc/disc.h"
+#include "disc/track.h"
+#include "utils/file.h"
+
+namespace disc::test {
+// Fake disc with tracks stored back to back starting at firstTrackStart.
+// Track numbers are 0-based and positions outside of tracks are reported as track -1 (like Cue),
+// formats with different conventions can override track queries.
+struct TestDisc : public Disc {
+    struct TrackInfo {
+        int frames;
+        TrackType type;
+    };
+
+    std::vector<TrackInfo> tracks;
+    int firstTrackStart;
+    std::string file;
+
+    // Writes contents of sector at lba, sector is zeroed before the call. Sectors are all zeroes if not set.
+    std::function<void(int lba, uint8_t* sector)> fill;
+    int reads = 0;
+
+    TestDisc(std::vector<TrackInfo> tracks, int firstTrackStart = 150) : tracks(std::move(tracks)), firstTrackStart(firstTrackStart) {}
+
+    Sector read(Position pos) override {
+        reads++;
+        sector.fill(0);
+        if (fill) fill(pos.toLba(), sector.data());
+
+        int track = getTrackByPosition(pos);
+        TrackType type = (track >= 0 && (size_t)track < tracks.size()) ? tracks[track].type : TrackType::INVALID;
+        return {sector.data(), sector.size(), type};
+    }
+
+    std::string getFile() const override { return file; }
+    size_t getTrackCount() const override { return tracks.size(); }
+
+    int getTrackByPosition(Position pos) const override {
+        int lba = pos.toLba();
+        for (size_t i = 0; i < tracks.size(); i++) {
+            if (lba >= trackStartLba(i) && lba < trackStartLba(i) + tracks[i].frames) return i;
+        }
+        return -1;
+    }
+
+    Position getTrackStart(int track) const override { return Position::fromLba(trackStartLba(track)); }
+    Position getTrackLength(int track) const override { return Position::fromLba(tracks.at(track).frames); }
+    Position getDiskSize() const override { return Position::fromLba(trackStartLba(tracks.size())); }
+
+    // First sector of track, track count gives the end of the last track
+    int trackStartLba(size_t track) const {
+        int lba = firstTrackStart;
+        for (size_t i = 0; i < track && i < tracks.size(); i++) lba += tracks[i].frames;
+        return lba;
+    }
+
+   private:
+    std::array<uint8_t, Track::SECTOR_SIZE> sector;
+};
+
+// Directory for files created by tests, ends with path separator
+inline std::string tempDirectory() {
+    for (const char* var : {"TMPDIR", "TEMP", "TMP"}) {
+        const char* dir = getenv(var);
+        if (dir != nullptr && *dir != '\0') return std::string(dir) + "/";
+    }
+    return "/tmp/";
+}
+
+// File in temp directory, removed when going out of scope.
+// Must outlive images opened from it, they keep the file open or mapped.
+class TempFile {
+   public:
+    explicit TempFile(const std::string& name) : path(tempDirectory() + "avocado_test_" + name) {}
+    ~TempFile() { remove(path.c_str()); }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& getPath() const { return path; }
+    bool write(const std::vector<uint8_t>& contents) const { return putFileContents(path, contents); }
+
+   private:
+    std::string path;
+};
+}  // namespace disc::test
@@ -11,4 +11,10 @@ TEST_CASE("Extend 10bit integer - negative", "[extend_sign]") { REQUIRE(extend_s
 
 TEST_CASE("Extend 10bit integer - negative with garbage", "[extend_sign]") { REQUIRE(extend_sign<10>(0x77FF) == (int16_t)0xFFFF); }
 
+TEST_CASE("Lowest set bit", "[lowest_set_bit]") {
+    REQUIRE(lowestSetBit(1) == 0);
+    REQUIRE(lowestSetBit(0x00800100) == 8);
+    REQUIRE(lowestSetBit(0x80000000) == 31);
+}
+
 }  // namespace utils
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "utils/ring_buffer.h"
+#include <catch2/catch.hpp>
+#include <thread>
+
+TEST_CASE("RingBuffer capacity is rounded up to power of two", "[ring_buffer]") {
+    RingBuffer<int16_t> buffer(100);
+    REQUIRE(buffer.capacity() == 128);
+    REQUIRE(buffer.size() == 0);
+}
+
+TEST_CASE("RingBuffer wraps around", "[ring_buffer]") {
+    RingBuffer<int> buffer(8);
+    int data[6] = {1, 2, 3, 4, 5, 6};
+    int out[8] = {};
+
+    REQUIRE(buffer.push(data, 6) == 6);
+    REQUIRE(buffer.pop(out, 4) == 4);
+    REQUIRE(buffer.push(data, 6) == 6);  // Crosses end of storage
+    REQUIRE(buffer.size() == 8);
+
+    REQUIRE(buffer.pop(out, 8) == 8);
+    int expected[8] = {5, 6, 1, 2, 3, 4, 5, 6};
+    for (int i = 0; i < 8; i++) {
+        REQUIRE(out[i] == expected[i]);
+    }
+}
+
+TEST_CASE("RingBuffer push drops elements that do not fit", "[ring_buffer]") {
+    RingBuffer<int> buffer(4);
+    int data[6] = {1, 2, 3, 4, 5, 6};
+    int out[6] = {};
+
+    REQUIRE(buffer.push(data, 6) == 4);
+    REQUIRE(buffer.pop(out, 6) == 4);
+    REQUIRE(out[3] == 4);
+    REQUIRE(buffer.pop(out, 6) == 0);
+}
+
+TEST_CASE("RingBuffer clear is applied by consumer", "[ring_buffer]") {
+    RingBuffer<int> buffer(4);
+    int data[2] = {1, 2};
+    int out[2] = {};
+
+    buffer.push(data, 2);
+    buffer.clear();
+    REQUIRE(buffer.pop(out, 2) == 0);
+    REQUIRE(buffer.size() == 0);
+}
+
+TEST_CASE("RingBuffer keeps elements pushed after clear", "[ring_buffer]") {
+    RingBuffer<int> buffer(4);
+    int data[3] = {1, 2, 3};
+    int out[4] = {};
+
+    buffer.push(data, 2);
+    buffer.clear();
+    buffer.push(data + 2, 1);
+    REQUIRE(buffer.size() == 1);
+
+    REQUIRE(buffer.pop(out, 4) == 1);
+    REQUIRE(out[0] == 3);
+    REQUIRE(buffer.size() == 0);
+}
+
+TEST_CASE("RingBuffer keeps order between threads", "[ring_buffer]") {
+    const uint32_t count = 1000000;
+    RingBuffer<uint32_t> buffer(1024);
+
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < count;) {
+            i += (uint32_t)buffer.push(&i, 1);
+        }
+    });
+
+    bool ordered = true;
+    for (uint32_t expected = 0; expected < count;) {
+        uint32_t value;
+        if (buffer.pop(&value, 1) == 0) continue;
+        if (value != expected) ordered = false;
+        expected++;
+    }
+    producer.join();
+
+    REQUIRE(ordered);
+}
@@ -0,0 +1,125 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "config.h"
+#include "disc/format/cbin.h"
+#include "disc/load.h"
+#include "utils/file.h"
+
+using namespace disc;
+
+namespace {
+void printHelp() {
+    printf(R"(
+usage: disc2cbin [options] image.cue|bin|iso|chd|ecm [output.cbin]
+  --level=N - LZMA and FLAC compression level, 0 - 9 (default 9)
+  --verify  - read back converted image and compare sectors and subchannel Q with the source
+  --help    - print help
+)");
+}
+
+bool verify(Disc& source, Disc& converted) {
+    uint32_t sectors = source.getDiskSize().toLba();
+    std::vector<uint8_t> expected;
+
+    for (uint32_t lba = 0; lba < sectors; lba++) {
+        auto pos = Position::fromLba(lba);
+
+        // Pregap is not converted, formats disagree on what is there
+        if (converted.getTrackByPosition(pos) == -1) continue;
+
+        auto a = source.read(pos);
+        expected.assign(a.begin(), a.end());
+        auto b = converted.read(pos);
+        if (a.type != b.type || (a.type != TrackType::INVALID && !std::equal(expected.begin(), expected.end(), b.begin(), b.end()))) {
+            printf("Sector %s differs\n", pos.toString().c_str());
+            return false;
+        }
+
+        auto qa = source.getSubQ(pos);
+        auto qb = converted.getSubQ(pos);
+        if (qa.control.reg != qb.control.reg || memcmp(qa.data, qb.data, sizeof(qa.data)) != 0 || qa.crc16 != qb.crc16) {
+            printf("Subchannel Q of sector %s differs\n", pos.toString().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+};  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printHelp();
+        return 0;
+    }
+
+    std::vector<std::string> files;
+    int level = 9;
+    bool verifyOutput = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--level=", 8) == 0) {
+            level = atoi(argv[i] + 8);
+            continue;
+        }
+        if (strcmp(argv[i], "--verify") == 0) {
+            verifyOutput = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--help") == 0) {
+            printHelp();
+            return 0;
+        }
+        files.push_back(argv[i]);
+    }
+
+    if (files.empty()) {
+        printHelp();
+        return 1;
+    }
+
+    // Sequential conversion, no need for background reading
+    config.options.emulator.readAhead = false;
+
+    std::string input = files[0];
+    auto source = disc::load(input);
+    if (!source) {
+        printf("Cannot load %s\n", input.c_str());
+        return 1;
+    }
+
+    std::string output = files.size() > 1 ? files[1] : getPath(input) + getFilename(input) + ".cbin";
+
+    auto start = std::chrono::steady_clock::now();
+    if (!format::Cbin::write(*source, output, level)) {
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double inputSize = source->getDiskSize().toLba() * 2352.0;
+    double outputSize = getFileSize(output);
+    printf("%s -> %s, %.1f MB -> %.1f MB (%.1f%%) in %.2f s\n", getFilenameExt(input).c_str(), getFilenameExt(output).c_str(),
+           inputSize / (1024 * 1024), outputSize / (1024 * 1024), 100.0 * outputSize / inputSize, seconds);
+
+    if (verifyOutput) {
+        auto converted = format::Cbin::open(output);
+        if (!converted || !verify(*source, *converted)) {
+            return 1;
+        }
+
+        // Decompression speed of the converted image, compared against realtime 2x speed
+        start = std::chrono::steady_clock::now();
+        uint32_t sectors = converted->getDiskSize().toLba();
+        volatile uint8_t sink = 0;
+        for (uint32_t lba = 0; lba < sectors; lba++) {
+            auto sector = converted->read(Position::fromLba(lba));
+            if (!sector.empty()) sink = sector[0];
+        }
+        (void)sink;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("Verified, sequential read %.1f MB/s (%.0fx CD speed)\n", inputSize / seconds / (1024 * 1024), sectors / seconds / 75.0);
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "disc/format/ecm_parser.h"
+#include "disc/format/ecm_sector.h"
+#include "utils/file.h"
+
+using namespace disc::format;
+
+namespace {
+const size_t CHUNK_SIZE = 1024 * 1024;  // Unit of work for a single thread
+
+void printHelp() {
+    printf(R"(
+usage: ecm2bin [options] image.ecm [output.bin]
+  --threads=N - number of decoding threads (default: number of cores)
+  --benchmark - measure EDC, ECC and image decoding throughput, no file is written
+  --help      - print help
+)");
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double megabytesPerSecond(uint64_t bytes, double seconds) { return bytes / seconds / (1024.0 * 1024.0); }
+
+// Decodes whole image splitting it into chunks between threads, output is called for every chunk (in any order).
+// Each thread uses its own Ecm, so file access is not shared.
+template <typename Output>
+bool decodeParallel(const std::string& input, int threads, uint64_t size, Output output) {
+    std::atomic<uint64_t> nextChunk{0};
+    std::atomic<bool> failed{false};
+    uint64_t chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    auto worker = [&]() {
+        auto ecm = EcmParser().parse(input.c_str());
+        if (!ecm) {
+            failed = true;
+            return;
+        }
+
+        std::vector<uint8_t> buffer(CHUNK_SIZE);
+        for (uint64_t chunk; (chunk = nextChunk++) < chunks && !failed;) {
+            uint64_t offset = chunk * CHUNK_SIZE;
+            size_t length = (size_t)std::min<uint64_t>(CHUNK_SIZE, size - offset);
+
+            ecm->decode(offset, buffer.data(), length);
+            if (!output(offset, buffer.data(), length)) {
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    return !failed;
+}
+
+void benchmarkSector() {
+    const int SECTORS = 100000;
+    uint8_t frame[2352];
+    for (size_t i = 0; i < sizeof(frame); i++) frame[i] = rand();
+
+    volatile uint32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SECTORS; i++) {
+        frame[0x10] = i;
+        sink = ecm::calculateEDC(frame + 0x10, 0x808);
+    }
+    printf("EDC:        %8.1f MB/s\n", megabytesPerSecond((uint64_t)SECTORS * 0x808, secondsSince(start)));
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SECTORS; i++) {
+        frame[0x10] = i;
+        ecm::calculateECC(frame);
+    }
+    sink = frame[0x8c8];
+    printf("ECC:        %8.1f MB/s\n", megabytesPerSecond((uint64_t)SECTORS * sizeof(frame), secondsSince(start)));
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SECTORS; i++) {
+        frame[0x14] = i;
+        ecm::decodeSector(ecm::Type::Mode2Form1, frame + 0x14, frame);
+    }
+    sink = frame[0];
+    printf("Mode2Form1: %8.1f MB/s\n", megabytesPerSecond((uint64_t)SECTORS * sizeof(frame), secondsSince(start)));
+    (void)sink;
+}
+
+std::string outputPath(const std::string& input) {
+    std::string ext = getExtension(input);
+    std::transform(ext.begin(), ext.end(), ext.begin(), tolower);
+
+    if (ext.empty()) {
+        return input + ".bin";
+    }
+
+    // image.bin.ecm -> image.bin
+    std::string base = input.substr(0, input.size() - ext.size() - 1);
+    if (ext == "ecm" && !getExtension(base).empty()) {
+        return base;
+    }
+    return base + ".bin";
+}
+};  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printHelp();
+        return 0;
+    }
+
+    std::vector<std::string> files;
+    bool benchmark = false;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--benchmark") == 0) {
+            benchmark = true;
+            continue;
+        }
+        if (strncmp(argv[i], "--threads=", 10) == 0) {
+            threads = std::max(1, atoi(argv[i] + 10));
+            continue;
+        }
+        if (strcmp(argv[i], "--help") == 0) {
+            printHelp();
+            return 0;
+        }
+        files.push_back(argv[i]);
+    }
+
+    if (files.empty()) {
+        if (!benchmark) {
+            printHelp();
+            return 1;
+        }
+        benchmarkSector();
+        return 0;
+    }
+
+    std::string input = files[0];
+    auto ecm = EcmParser().parse(input.c_str());
+    if (!ecm) {
+        return 1;
+    }
+    uint64_t size = ecm->getImageSize();
+    ecm.reset();
+
+    if (benchmark) {
+        benchmarkSector();
+
+        for (int n : {1, threads}) {
+            auto start = std::chrono::steady_clock::now();
+            decodeParallel(input, n, size, [](uint64_t, const uint8_t*, size_t) { return true; });
+            printf("Image, %2d thread(s): %8.1f MB/s\n", n, megabytesPerSecond(size, secondsSince(start)));
+            if (threads == 1) break;
+        }
+        return 0;
+    }
+
+    std::string output = files.size() > 1 ? files[1] : outputPath(input);
+    auto f = unique_ptr_file(fopen(output.c_str(), "wb"));
+    if (!f) {
+        printf("Cannot create %s\n", output.c_str());
+        return 1;
+    }
+
+    std::mutex writeMutex;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = decodeParallel(input, threads, size, [&](uint64_t offset, const uint8_t* data, size_t length) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        fseek(f.get(), (long)offset, SEEK_SET);
+        return fwrite(data, 1, length, f.get()) == length;
+    });
+    f.reset();
+
+    if (!ok) {
+        printf("Conversion of %s failed\n", input.c_str());
+        return 1;
+    }
+
+    double seconds = secondsSince(start);
+    printf("%s -> %s, %.1f MB in %.2f s (%.1f MB/s, %d threads)\n", getFilenameExt(input).c_str(), getFilenameExt(output).c_str(),
+           size / (1024.0 * 1024.0), seconds, megabytesPerSecond(size, seconds), threads);
+    return 0;
+}